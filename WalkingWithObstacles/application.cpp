@@ -22,15 +22,61 @@
 */
 
 
+# include <cstring>
+
+# include "batch.h"
+# include "benchmark.h"
 # include "utilities.h"
 # include "graphics.h"
+# include "replay.h"
 
 # include "gl\glut.h"
 
 // -------------------- Namespace: Application --------------------
 namespace Application {
+	static bool profile = false;										// true: Dump profiled zones when the application exits
+	static bool statistics = false;										// true: Dump frame statistics when the application exits
+
+	static void ParseArguments(int argc, char** argv) {					// Parse the command line options left after glut has removed its own
+		for (int i = 1; i < argc; i++) {
+			if (strcmp(argv[i], "--profile") == 0) {					// --profile [file] -> Dump profiled zones on exit (F12 dumps them at any time)
+				profile = true;
+				if (i + 1 < argc && argv[i + 1][0] != '-')
+					Profiler::SetOutput(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--statistics") == 0) {			// --statistics [file] -> Dump OpenGL calls per frame of every scene on exit
+				statistics = true;
+				if (i + 1 < argc && argv[i + 1][0] != '-')
+					Statistics::SetOutput(argv[++i]);
+			}
+			else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)	// --record file -> Record the keys of the walks into file
+				Replay::Record(argv[++i]);
+			else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)	// --replay file -> Replay the walk recorded in file & exit when it is over
+				Replay::Load(argv[++i]);
+			else if (strcmp(argv[i], "--crowd") == 0) {					// --crowd [runners] -> Walks are shared with AI runners (by default 300)
+				int runners = 300;
+				if (i + 1 < argc && argv[i + 1][0] != '-')
+					runners = atoi(argv[++i]);
+				Graphics::SetCrowd(runners);
+			}
+			else if (strcmp(argv[i], "--benchmark") == 0) {				// --benchmark -> Run the microbenchmarks & exit (no window is created)
+				Benchmark::Scroll();
+				Benchmark::Walk();
+				exit(0);
+			}
+			else if (strcmp(argv[i], "--batch") == 0) {					// --batch [runs] -> Run headless walks per key policy, print hit statistics & exit
+				int runs = 1000;
+				if (i + 1 < argc && argv[i + 1][0] != '-')
+					runs = atoi(argv[++i]);
+				Batch::Main(runs);
+				exit(0);
+			}
+		}
+	}
+
 	void Init(int* argc, char** argv) {									// Initialize Application
 		glutInit(argc, argv);											// Initialize the glut library
+		ParseArguments(*argc, argv);									// Parse the rest of the command line
 		glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA | GLUT_DEPTH);		// Set the display mode
 		glutCreateWindow("Graphics 1 - Animation Project 2012-2013");	// Create window with title Graphics 1 Project 2012-2013...
 		glutFullScreen();												// Enter full screen mode
@@ -42,9 +88,15 @@ namespace Application {
 		glutIdleFunc(Graphics::animate);								// Set as our idle function - makes the world move
 		glutKeyboardFunc(Graphics::keyboard);							// Is called each time a key press generates an ASCII character
 		glutSpecialFunc(Graphics::specialKeyboard);						// Is called each time keyboard function or directional keys are pressed
+		if (Replay::IsReplaying())
+			Graphics::SceneManager::Start(Replay::GetCharacter());		// A replay starts with its walk
 	}
 
 	void Exit() {														// Clean up Application
+		if (profile)
+			Profiler::Dump();											// Dump profiled zones before anything is cleaned
+		if (statistics)
+			Statistics::Dump();
 		Graphics::Exit();												// Clean up Graphics Library
 		Utilities::Exit();												// Clean up Utilities Library (has to be cleaned last)
 		exit(1);
@@ -0,0 +1,90 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <mutex>
+
+# include "arena.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+static void* spare = NULL;												// Blocks of BLOCK_SIZE given back by released arenas - linked through their first bytes
+static std::mutex spareMutex;											// Scenes may be built on other threads
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Class: Arena --------------------
+Arena::Arena() : blocks(NULL), current(NULL), end(NULL), used(0) {
+}
+
+Arena::~Arena() {
+	release();
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+	char* p = (char*)(((size_t)current + alignment - 1) & ~(alignment - 1));
+	if (current == NULL || p + size > end) {							// Doesn't fit - start a new block
+		size_t blockSize = sizeof(Block) + size + alignment > BLOCK_SIZE ? sizeof(Block) + size + alignment : BLOCK_SIZE;
+		Block* block = NULL;
+		if (blockSize == BLOCK_SIZE) {
+			std::lock_guard <std::mutex> lock(spareMutex);
+			if (spare != NULL) {
+				block = (Block*)spare;
+				spare = *(void**)spare;
+			}
+		}
+		if (block == NULL)
+			block = (Block*)::operator new(blockSize);
+		block->next = blocks;
+		block->size = blockSize;
+		blocks = block;
+		current = (char*)(block + 1);
+		end = (char*)block + blockSize;
+		p = (char*)(((size_t)current + alignment - 1) & ~(alignment - 1));
+	}
+	current = p + size;
+	used += size;
+	return p;
+}
+
+void Arena::release() {
+	while (blocks != NULL) {
+		Block* block = blocks;
+		blocks = block->next;
+		if (block->size == BLOCK_SIZE) {								// Kept for the next arenas
+			std::lock_guard <std::mutex> lock(spareMutex);
+			*(void**)block = spare;
+			spare = block;
+		}
+		else
+			::operator delete(block);
+	}
+	current = end = NULL;
+	used = 0;
+}
+
+size_t Arena::getUsed() const {
+	return used;
+}
+// -------------------- Class: Arena --------------------
\ No newline at end of file
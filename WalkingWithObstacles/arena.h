@@ -0,0 +1,95 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __ARENA__
+# define __ARENA__
+
+# include <cstddef>														// size_t
+# include <new>															// Placement new
+# include <type_traits>													// Alignment
+# include <utility>														// Forward
+
+// -------------------- Class: Arena --------------------
+class Arena {															// Monotonic memory - allocations are bumped out of blocks & all of it is released at once
+public:
+	Arena();
+	~Arena();															// Release all memory (objects are not destroyed)
+
+	void* allocate(size_t size, size_t alignment);
+	void release();														// Give all blocks back - they are kept for the next arenas
+	size_t getUsed() const;												// Bytes allocated since the last release
+
+	template <class T, class... Args>
+	T* create(Args&&... args) {											// Construct an object in the arena
+		return new (allocate(sizeof(T), std::alignment_of<T>::value)) T(std::forward<Args>(args)...);
+	}
+
+	template <class T>
+	static void Destroy(T* object) {									// Destroy an object created in an arena - its memory stays until the arena is released
+		if (object != NULL)
+			object->~T();
+	}
+
+	static const size_t BLOCK_SIZE = 16384;								// Larger allocations get a block of their own
+
+private:
+	struct Block {														// Header of each block - the memory follows it
+		Block* next;
+		size_t size;
+	};
+
+	Block* blocks;														// Blocks in use (last one first)
+	char* current;														// Free memory of the last block
+	char* end;
+	size_t used;
+
+	Arena(const Arena&);												// An arena owns its memory - it can't be copied
+	Arena& operator=(const Arena&);
+};
+// -------------------- Class: Arena --------------------
+
+// -------------------- Class: ArenaAllocator --------------------
+template <class T>
+class ArenaAllocator {													// Allocator for the standard containers - memory comes from an arena & deallocate does nothing
+public:
+	typedef T value_type;
+
+	ArenaAllocator(Arena* arena) : arena(arena) {}
+	template <class U>
+	ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), std::alignment_of<T>::value)); }
+	void deallocate(T* p, size_t n) {}									// Released with the whole arena
+
+	Arena* arena;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena == b.arena; }
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena != b.arena; }
+// -------------------- Class: ArenaAllocator --------------------
+
+# endif  // # ifndef __ARENA__
\ No newline at end of file
@@ -0,0 +1,150 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <chrono>
+# include <iostream>
+# include <random>
+
+# include "batch.h"
+# include "simulation.h"
+# include "threadpool.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+static const char* policyNames[Batch::POLICIES] = { "Idle", "Random", "Reactive" };
+
+static float NextObstacle(const Simulation& simulation) {				// Distance to the next obstacle ahead of the runner (-1 if none)
+	const ObstacleRing& obstacles = simulation.getObstacles();
+	for (int i = 0; i < obstacles.size(); i++)
+		if (obstacles.getPositionX(i) > 5.0f)							// Ordered - the first one in front of the runner
+			return obstacles.getPositionX(i);
+	return -1.0f;
+}
+
+static int Decide(const Batch::Run& run, const Simulation& simulation, std::minstd_rand& random) {	// Keys pressed by the policy in the next tick
+	const Motion& runner = simulation.getRunner();
+	int inputs = 0;
+	if (run.policy == Batch::IDLE)
+		return inputs;
+	if (runner.getSpeed() < run.speed)
+		inputs |= Simulation::SPEED_UP;
+	else if (runner.getSpeed() > run.speed + Motion::SPEED_CHANGE)
+		inputs |= Simulation::SLOW_DOWN;
+	if (run.policy == Batch::RANDOM) {
+		if (random() % 50 == 0)											// About one jump per second
+			inputs |= Simulation::JUMP;
+	}
+	else if (run.policy == Batch::REACTIVE) {
+		float distance = NextObstacle(simulation);
+		if (distance >= 0.0f && distance < 6.0f * runner.getSpeed())	// Top of the jump about above the obstacle
+			inputs |= Simulation::JUMP;
+	}
+	return inputs;
+}
+
+static void Walk(Batch::Run& run) {
+	Simulation simulation(run.seed);
+	std::minstd_rand random(run.seed);
+	double speeds = 0.0;
+	int moving = 0;
+	run.firstHit = -1.0;
+	for (int t = 0; t < run.ticks; t++) {
+		int events = simulation.step(Decide(run, simulation, random), run.tick);
+		if (events & Simulation::HIT && run.firstHit < 0.0)
+			run.firstHit = simulation.getTraveled() - Simulation::RANGE;
+		if (!simulation.isHit()) {
+			speeds += simulation.getRunner().getSpeed();
+			moving++;
+		}
+	}
+	run.hits = simulation.getHits();
+	run.traveled = simulation.getTraveled() - Simulation::RANGE;		// Walks start RANGE into the course
+	run.averageSpeed = moving > 0 ? speeds / moving : 0.0;
+}
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Namespace: Batch --------------------
+namespace Batch {
+	void Simulate(std::vector <Run>& runs, ThreadPool& pool) {
+		pool.parallelFor(0, (int)runs.size(), 1, [&runs](int first, int last) {	// Each task writes only its own walks
+			for (int i = first; i < last; i++)
+				Walk(runs[i]);
+		});
+	}
+
+	Summary Summarize(const std::vector <Run>& runs, int policy) {
+		Summary summary = { 0, 0, 0.0, 0.0, 0.0 };
+		double traveled = 0.0;
+		int hits = 0;
+		for (unsigned i = 0; i < runs.size(); i++) {
+			const Run& run = runs[i];
+			if (policy != POLICIES && run.policy != policy)
+				continue;
+			summary.runs++;
+			if (run.firstHit >= 0.0) {
+				summary.runsHit++;
+				summary.firstHit += run.firstHit;
+			}
+			hits += run.hits;
+			traveled += run.traveled;
+			summary.averageSpeed += run.averageSpeed;
+		}
+		if (summary.runsHit > 0)
+			summary.firstHit /= summary.runsHit;
+		if (traveled > 0.0)
+			summary.hitRate = hits * 1000.0 / traveled;
+		if (summary.runs > 0)
+			summary.averageSpeed /= summary.runs;
+		return summary;
+	}
+
+	void Main(int runs) {
+		ThreadPool pool;
+		std::vector <Run> walks;
+		walks.reserve(runs * POLICIES);
+		for (int policy = 0; policy < POLICIES; policy++)
+			for (int i = 0; i < runs; i++) {
+				Run run;
+				run.seed = i + 1;										// Same courses for every policy
+				run.policy = policy;
+				run.speed = Motion::MIN_SPEED + (Motion::MAX_SPEED - Motion::MIN_SPEED) * (i % 4) / 3.0f;	// Slow to fast
+				run.ticks = 20000;										// About 5 minutes of a walk
+				run.tick = 16;
+				walks.push_back(run);
+			}
+		std::cout << "Batch: " << walks.size() << " walks of 20000 ticks on " << pool.getThreads() << " threads" << std::endl;
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		Simulate(walks, pool);
+		double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		for (int policy = 0; policy < POLICIES; policy++) {
+			Summary summary = Summarize(walks, policy);
+			std::cout << "  " << policyNames[policy] << ": " << summary.runsHit << "/" << summary.runs << " walks hit, first hit after "
+				<< summary.firstHit << " units, " << summary.hitRate << " hits per 1000 units, average speed " << summary.averageSpeed << std::endl;
+		}
+		std::cout << "  " << time << " ms (" << walks.size() * 20000.0 / time / 1000.0 << " million ticks per second)" << std::endl;
+	}
+};
+// -------------------- Namespace: Batch --------------------
\ No newline at end of file
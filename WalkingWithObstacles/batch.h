@@ -0,0 +1,67 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __BATCH__
+# define __BATCH__
+
+# include <vector>
+
+class ThreadPool;
+
+// -------------------- Namespace: Batch --------------------
+namespace Batch {														// Many headless walks run in parallel - statistics used to tune the course
+	enum Policies { IDLE, RANDOM, REACTIVE, POLICIES };					// How keys are pressed in a walk: never, at random, or jumping when an obstacle comes close
+
+	class Run {															// Settings & results of a walk
+	public:
+		unsigned seed;													// Seed of the course
+		int policy;
+		float speed;													// Speed the policy keeps the runner at
+		int ticks;														// Length of the walk
+		int tick;														// Length of each tick (in milliseconds)
+
+		double firstHit;												// Distance traveled before the first hit (-1 if none)
+		int hits;
+		double traveled;
+		double averageSpeed;											// Average speed over the ticks the runner was moving
+	};
+
+	class Summary {														// Statistics of many walks
+	public:
+		int runs;
+		int runsHit;													// Walks with at least one hit
+		double firstHit;												// Average distance before the first hit (of the walks with a hit)
+		double hitRate;													// Hits per 1000 units traveled
+		double averageSpeed;
+	};
+
+	void Simulate(std::vector <Run>& runs, ThreadPool& pool);			// Run all walks on the pool - their results are written in them
+	Summary Summarize(const std::vector <Run>& runs, int policy);		// Statistics of the walks of a policy (POLICIES: all walks)
+
+	void Main(int runs);												// Run the given number of walks per policy & print the statistics (--batch)
+};
+// -------------------- Namespace: Batch --------------------
+
+# endif  // # ifndef __BATCH__
\ No newline at end of file
@@ -0,0 +1,89 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <chrono>
+# include <iostream>
+
+# include "benchmark.h"
+# include "entities.h"
+# include "simulation.h"
+
+// -------------------- Namespace: Benchmark --------------------
+namespace Benchmark {
+	static const char* kernelNames[EntityStore::KERNELS] = { "Scalar", "SSE2", "AVX" };
+
+	void Scroll() {
+		const int sizes[] = { 10000, 1000000 };
+		std::cout << "Benchmark: EntityStore::scroll (best kernel on this CPU: " << kernelNames[EntityStore::GetBestKernel()] << ")" << std::endl;
+		for (int s = 0; s < 2; s++) {
+			int entities = sizes[s], ticks = 200000000 / entities;		// Same total work for every size
+			double scalarTime = 0.0;
+			for (int kernel = EntityStore::SCALAR; kernel <= EntityStore::GetBestKernel(); kernel++) {
+				EntityStore store;
+				store.reserve(entities);
+				for (int i = 0; i < entities; i++)						// Spread over the visible part of the course (same layout for every kernel)
+					store.add(i % 10 == 0 ? EntityStore::OBSTACLE : EntityStore::SCENERY, (float)((i * 7919LL) % 6000 - 3000), 0.0f, 0.0f, 0);
+				EntityStore::SetKernel(kernel);
+				int hits = 0;
+				std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+				for (int t = 0; t < ticks; t++) {
+					store.scroll(1.75f, -3000.0f, 5.0f);
+					if (store.findHit(EntityStore::OBSTACLE) != -1)
+						hits++;
+				}
+				double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+				double checksum = 0.0;									// Has to be the same for every kernel
+				for (int i = 0; i < entities; i++)
+					checksum += store.getPositionsX()[i];
+				if (kernel == EntityStore::SCALAR)
+					scalarTime = time;
+				std::cout << "  " << entities << " entities - " << kernelNames[kernel] << ": " << time / ticks << " ms per tick, "
+					<< time * 1000000.0 / ((double)ticks * entities) << " ns per entity, x" << scalarTime / time << " (hits: " << hits << ", checksum: " << checksum << ")" << std::endl;
+			}
+		}
+		EntityStore::SetKernel(EntityStore::GetBestKernel());
+	}
+
+	void Walk() {
+		const int walks = 8, ticks = 2000000;
+		std::cout << "Benchmark: Simulation::step (" << walks << " walks of " << ticks << " ticks)" << std::endl;
+		long long hits = 0;
+		double traveled = 0.0;
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		for (int w = 0; w < walks; w++) {
+			Simulation simulation(w + 1);
+			for (int t = 0; t < ticks; t++) {							// Jump every 40 ticks & speed up every 500 (same inputs every run)
+				int inputs = (t % 40 == 0 ? Simulation::JUMP : 0) | (t % 500 == 0 ? Simulation::SPEED_UP : 0);
+				simulation.step(inputs, 16);
+			}
+			hits += simulation.getHits();
+			traveled += simulation.getTraveled();
+		}
+		double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		std::cout << "  " << time * 1000000.0 / ((double)walks * ticks) << " ns per tick, " << (double)walks * ticks / time / 1000.0
+			<< " million ticks per second (hits: " << hits << ", traveled: " << traveled << ")" << std::endl;
+	}
+};
+// -------------------- Namespace: Benchmark --------------------
\ No newline at end of file
@@ -0,0 +1,160 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include "course.h"
+# include "profiler.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+class Random {															// Small generator of our own (xorshift) - gives the same numbers with every compiler & library
+public:
+	Random(unsigned seed) : state(seed != 0 ? seed : 0x9E3779B9u) {
+		for (int i = 0; i < 4; i++)										// Mix similar seeds apart
+			next();
+	}
+
+	unsigned next() {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	float range(float min, float max) {									// Uniform in [min, max)
+		return min + (max - min) * (next() >> 8) / 16777216.0f;
+	}
+
+private:
+	unsigned state;
+};
+
+static const int SAFE_CHUNKS = 3;										// Chunks at the start without obstacles (the first two are behind the runner)
+static const float MAX_SPACING = 900.0f, MIN_SPACING = 400.0f;			// Distance between obstacles at the start & after many chunks
+static const float SPACING_CHANGE = 15.0f;								// Shrink of the spacing per chunk
+static const float SCENERY_SPACING = 250.0f;
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Class: Course --------------------
+const float Course::LENGTH = 1500.0f;
+
+Course::Course(unsigned seed, int ahead) : seed(seed), ahead(ahead), generated(0), chunks(ahead + 1), stop(false) {
+	ready.reserve(chunks.size());
+	spare.reserve(chunks.size());
+	for (unsigned i = 0; i < chunks.size(); i++)
+		spare.push_back(&chunks[i]);
+	worker = std::thread(&Course::work, this);
+}
+
+Course::~Course() {
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		stop = true;
+	}
+	changed.notify_all();
+	worker.join();
+}
+
+Chunk* Course::next() {
+	std::unique_lock <std::mutex> lock(mutex);
+	changed.wait(lock, [this] { return !ready.empty(); });
+	Chunk* chunk = ready.front();
+	ready.erase(ready.begin());
+	lock.unlock();
+	changed.notify_all();												// Worker can generate another one
+	return chunk;
+}
+
+void Course::recycle(Chunk* chunk) {
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		spare.push_back(chunk);
+	}
+	changed.notify_all();
+}
+
+unsigned Course::getSeed() const {
+	return seed;
+}
+
+void Course::Generate(unsigned seed, int index, Chunk& chunk) {
+	PROFILE_ZONE("Course::Generate");
+	Random random(seed ^ (unsigned)index * 0x9E3779B9u);				// Every chunk has a generator of its own
+	chunk.obstacles.clear();											// Buffers of the chunk's last use are kept
+	chunk.sceneryX.clear();
+	chunk.sceneryZ.clear();
+	chunk.sceneryKinds.clear();
+	chunk.index = index;
+	chunk.start = (double)index * LENGTH;
+	if (index >= SAFE_CHUNKS) {											// Obstacles - spacing shrinks the further the course goes
+		float spacing = MAX_SPACING - SPACING_CHANGE * (index - SAFE_CHUNKS);
+		if (spacing < MIN_SPACING)
+			spacing = MIN_SPACING;
+		int slots = (int)(LENGTH / spacing + 0.5f);
+		float slot = LENGTH / slots;
+		int pattern = random.next() % 4;
+		for (int i = 0; i < slots; i++) {
+			if (pattern == 0 && i == slots / 2 && slots > 2)			// Gap - an empty slot to rest
+				continue;
+			float x = (i + 0.5f) * slot + random.range(-0.15f, 0.15f) * slot;
+			if (pattern == 1 && i == slots / 2 && slot >= 1.2f * MIN_SPACING) {	// Pair - two obstacles close together (while the spacing is wide enough)
+				chunk.obstacles.push_back(x - 0.3f * slot);
+				chunk.obstacles.push_back(x + 0.3f * slot);
+			}
+			else
+				chunk.obstacles.push_back(x);
+		}
+	}
+	for (float x = 0.5f * SCENERY_SPACING; x < LENGTH; x += SCENERY_SPACING) {	// Scenery - trees on both sides, some containers
+		float posX = x + random.range(-0.2f, 0.2f) * SCENERY_SPACING;
+		bool left = random.next() % 2 == 0;
+		chunk.sceneryX.push_back(posX);
+		chunk.sceneryZ.push_back(left ? -300.0f : 100.0f);
+		chunk.sceneryKinds.push_back(Chunk::TREE);
+		if (left && random.next() % 2 == 0) {							// Container on the other side
+			chunk.sceneryX.push_back(posX);
+			chunk.sceneryZ.push_back(100.0f);
+			chunk.sceneryKinds.push_back(Chunk::CONTAINER);
+		}
+	}
+}
+
+void Course::work() {
+	std::unique_lock <std::mutex> lock(mutex);
+	while (true) {
+		changed.wait(lock, [this] { return stop || ((int)ready.size() < ahead && !spare.empty()); });
+		if (stop)
+			return;
+		int index = generated++;
+		Chunk* chunk = spare.back();
+		spare.pop_back();
+		lock.unlock();													// Generate without holding the lock
+		Generate(seed, index, *chunk);
+		lock.lock();
+		ready.push_back(chunk);
+		changed.notify_all();
+	}
+}
+// -------------------- Class: Course --------------------
\ No newline at end of file
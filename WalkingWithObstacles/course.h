@@ -0,0 +1,77 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __COURSE__
+# define __COURSE__
+
+# include <condition_variable>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+// -------------------- Class: Chunk --------------------
+class Chunk {															// Fixed length part of the course - positions are relative to its start
+public:
+	int index;															// Chunks are numbered from 0 (start of the course)
+	double start;														// Distance from the start of the course
+	std::vector <float> obstacles;										// Positions of the obstacles (ordered)
+	std::vector <float> sceneryX, sceneryZ;								// Positions of the scenery (ordered by x)
+	std::vector <unsigned char> sceneryKinds;
+
+	enum Kinds { TREE, CONTAINER };
+};
+// -------------------- Class: Chunk --------------------
+
+// -------------------- Class: Course --------------------
+class Course {															// Endless course generated from a seed - the same seed always gives the same course
+public:
+	Course(unsigned seed, int ahead = 4);								// Start a worker thread that keeps the given number of chunks ready
+	~Course();
+
+	Chunk* next();														// Take the next chunk of the course (waits only if the worker has fallen behind)
+	void recycle(Chunk* chunk);											// Give the chunk back once its content has been added - its buffers are reused
+	unsigned getSeed() const;
+
+	static void Generate(unsigned seed, int index, Chunk& chunk);		// Generate any chunk of any course - depends only on the seed & index
+
+	static const float LENGTH;											// Length of each chunk
+
+private:
+	void work();														// Worker thread - generates chunks ahead of need
+
+	unsigned seed;
+	int ahead;
+	int generated;														// Index of the next chunk to generate
+	std::vector <Chunk> chunks;											// All chunks (ahead + 1) - allocated once, then recycled
+	std::vector <Chunk*> ready;											// Generated chunks not taken yet (in order)
+	std::vector <Chunk*> spare;											// Chunks free to be generated
+	bool stop;
+	std::mutex mutex;
+	std::condition_variable changed;									// Signals a chunk generated, taken or recycled
+	std::thread worker;
+};
+// -------------------- Class: Course --------------------
+
+# endif  // # ifndef __COURSE__
\ No newline at end of file
@@ -0,0 +1,86 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include "crowd.h"
+# include "simulation.h"
+# include "threadpool.h"
+
+// -------------------- Class: Crowd --------------------
+const float Crowd::RANGE = 2500.0f;
+
+Crowd::Crowd(int runners, unsigned seed) : kinds(runners), posX(runners), posZ(runners), speeds(runners), phases(runners),
+heights(runners, 0.0f), jumps(runners, -1.0f), jumpHeights(runners, 0.0f), random(seed) {
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	for (int i = 0; i < runners; i++) {
+		kinds[i] = (unsigned char)(i % KINDS);
+		posX[i] = RANGE * (2.0f * unit(random) - 1.0f);
+		posZ[i] = -230.0f + 460.0f * unit(random);						// Anywhere on the path
+		if (posZ[i] > -150.0f && posZ[i] < 100.0f)						// Keep clear of the runner & its ghost
+			posZ[i] += posZ[i] < -25.0f ? -100.0f : 150.0f;
+		speeds[i] = Motion::MIN_SPEED + (Motion::MAX_SPEED - Motion::MIN_SPEED) * unit(random);
+		phases[i] = unit(random);
+	}
+}
+
+void Crowd::step(int tick, float speed, const ObstacleRing& obstacles, ThreadPool* pool) {
+	if (pool == NULL)
+		step(0, size(), tick, speed, obstacles);
+	else																// Runners don't depend on each other
+		pool->parallelFor(0, size(), GRAIN, [this, tick, speed, &obstacles](int first, int last) { step(first, last, tick, speed, obstacles); });
+}
+
+void Crowd::step(int first, int last, int tick, float speed, const ObstacleRing& obstacles) {
+	int count = obstacles.size();
+	for (int i = first; i < last; i++) {
+		phases[i] += Motion::Advance(speeds[i], tick);					// Same run cycle as Motion
+		phases[i] -= (int)phases[i];
+		posX[i] += Motion::Distance(speeds[i] - speed, tick);
+		if (posX[i] < -RANGE)
+			posX[i] += 2.0f * RANGE;
+		else if (posX[i] > RANGE)
+			posX[i] -= 2.0f * RANGE;
+		if (jumps[i] >= 0.0f) {											// Same height & length as a jump of Motion
+			jumps[i] += tick / Motion::JumpLength(speeds[i]);
+			if (jumps[i] >= 1.0f) {
+				jumps[i] = -1.0f;
+				heights[i] = 0.0f;
+			}
+			else
+				heights[i] = jumpHeights[i] * Motion::SampleJump(jumps[i]);
+			continue;
+		}
+		for (int j = 0; j < count; j++) {								// Obstacles are ordered - stop at the first one ahead
+			float distance = obstacles.getPositionX(j) - posX[i];
+			if (distance <= 0.0f)
+				continue;
+			if (distance < 6.0f * speeds[i]) {
+				jumps[i] = 0.0f;
+				jumpHeights[i] = Motion::JumpHeight(speeds[i]);
+			}
+			break;
+		}
+	}
+}
+// -------------------- Class: Crowd --------------------
\ No newline at end of file
@@ -0,0 +1,64 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __CROWD__
+# define __CROWD__
+
+# include <random>
+# include <vector>
+
+# include "entities.h"
+
+class ThreadPool;
+
+// -------------------- Class: Crowd --------------------
+class Crowd {															// AI runners sharing the course with the runner of a walk - stored as arrays & updated in bulk (no rendering)
+public:
+	Crowd(int runners, unsigned seed);									// Runners of all kinds spread over the path
+
+	void step(int tick, float speed, const ObstacleRing& obstacles, ThreadPool* pool = NULL);	// Advance all runners by a tick - speed: of the walk's runner (the content moves by it)
+
+	int size() const { return (int)kinds.size(); }
+	const unsigned char* getKinds() const { return &kinds[0]; }			// Character::kindOf of each runner
+	const float* getPositionsX() const { return &posX[0]; }				// Relative to the walk's runner
+	const float* getPositionsZ() const { return &posZ[0]; }
+	const float* getHeights() const { return &heights[0]; }
+	const float* getPhases() const { return &phases[0]; }				// Position in the running cycle [0, 1)
+
+	static const float RANGE;											// Runners are kept within [-RANGE, RANGE] of the walk's runner - they wrap around
+	static const int KINDS = 3;
+	static const int GRAIN = 1024;										// Runners stepped by a task of the pool - smaller crowds are stepped on the calling thread
+
+private:
+	void step(int first, int last, int tick, float speed, const ObstacleRing& obstacles);	// Advance the runners [first, last)
+
+	std::vector <unsigned char> kinds;
+	std::vector <float> posX, posZ, speeds, phases;
+	std::vector <float> heights, jumps, jumpHeights;					// jumps: progress of the current jump [0, 1) (-1: on the ground)
+	std::minstd_rand random;
+};
+// -------------------- Class: Crowd --------------------
+
+# endif  // # ifndef __CROWD__
\ No newline at end of file
@@ -0,0 +1,290 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <intrin.h>													// Intrinsics - SSE, AVX & cpuid
+
+# include "entities.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+typedef void(*ScrollKernel)(float* x, int first, int last, float distance, float minX, float hitX, unsigned* hits, unsigned* wraps);
+
+static void ScrollScalar(float* x, int first, int last, float distance, float minX, float hitX, unsigned* hits, unsigned* wraps) {
+	for (int i = first; i < last; i++) {
+		x[i] -= distance;
+		if (x[i] <= hitX && x[i] >= -hitX - distance)					// Has been within [-hitX, hitX] at some point of the move
+			hits[i >> 5] |= 1u << (i & 31);
+		else if (x[i] < minX) {											// If entity is out of view - re-add it!
+			x[i] = -x[i];
+			wraps[i >> 5] |= 1u << (i & 31);
+		}
+	}
+}
+
+static void ScrollSSE2(float* x, int first, int last, float distance, float minX, float hitX, unsigned* hits, unsigned* wraps) {
+	__m128 d = _mm_set1_ps(distance), m = _mm_set1_ps(minX), h = _mm_set1_ps(hitX), l = _mm_set1_ps(-hitX - distance), sign = _mm_set1_ps(-0.0f);
+	int i;
+	for (i = first; i + 4 <= last; i += 4) {							// 4 entities at a time - a group never crosses a word of the bitmasks
+		__m128 v = _mm_sub_ps(_mm_loadu_ps(x + i), d);
+		__m128 hit = _mm_and_ps(_mm_cmple_ps(v, h), _mm_cmpge_ps(v, l));
+		__m128 wrap = _mm_cmplt_ps(v, m);
+		_mm_storeu_ps(x + i, _mm_xor_ps(v, _mm_and_ps(wrap, sign)));	// Flip the sign of the wrapped ones
+		hits[i >> 5] |= (unsigned)_mm_movemask_ps(hit) << (i & 31);
+		wraps[i >> 5] |= (unsigned)_mm_movemask_ps(wrap) << (i & 31);
+	}
+	ScrollScalar(x, i, last, distance, minX, hitX, hits, wraps);		// Remaining entities
+}
+
+static void ScrollAVX(float* x, int first, int last, float distance, float minX, float hitX, unsigned* hits, unsigned* wraps) {
+	__m256 d = _mm256_set1_ps(distance), m = _mm256_set1_ps(minX), h = _mm256_set1_ps(hitX), l = _mm256_set1_ps(-hitX - distance), sign = _mm256_set1_ps(-0.0f);
+	int i;
+	for (i = first; i + 8 <= last; i += 8) {							// 8 entities at a time
+		__m256 v = _mm256_sub_ps(_mm256_loadu_ps(x + i), d);
+		__m256 hit = _mm256_and_ps(_mm256_cmp_ps(v, h, _CMP_LE_OQ), _mm256_cmp_ps(v, l, _CMP_GE_OQ));
+		__m256 wrap = _mm256_cmp_ps(v, m, _CMP_LT_OQ);
+		_mm256_storeu_ps(x + i, _mm256_xor_ps(v, _mm256_and_ps(wrap, sign)));
+		hits[i >> 5] |= (unsigned)_mm256_movemask_ps(hit) << (i & 31);
+		wraps[i >> 5] |= (unsigned)_mm256_movemask_ps(wrap) << (i & 31);
+	}
+	_mm256_zeroupper();													// Avoid the penalty of mixing AVX with the SSE code that follows
+	ScrollScalar(x, i, last, distance, minX, hitX, hits, wraps);
+}
+
+static const ScrollKernel kernels[EntityStore::KERNELS] = { ScrollScalar, ScrollSSE2, ScrollAVX };
+
+static int DetectKernel() {												// Check what the CPU (and the OS for AVX) supports
+	int info[4];
+	__cpuid(info, 1);
+	bool sse2 = (info[3] & (1 << 26)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0 && (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;	// AVX & OS saves the YMM registers
+	return avx ? EntityStore::AVX : sse2 ? EntityStore::SSE2 : EntityStore::SCALAR;
+}
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Namespace: Collision --------------------
+namespace Collision {
+	float Sweep(float endX, float distance, float hitX, float startHeight, float endHeight, float clearance) {
+		float enter = 0.0f, exit = 1.0f;								// Part of the tick the content spends within [-hitX, hitX]
+		if (distance > 0.0f) {											// x(t) = endX + distance * (1 - t)
+			enter = (endX + distance - hitX) / distance;
+			exit = (endX + distance + hitX) / distance;
+			if (enter < 0.0f)
+				enter = 0.0f;
+			if (exit > 1.0f)
+				exit = 1.0f;
+		}
+		else if (endX > hitX || endX < -hitX)
+			return -1.0f;
+		if (enter > exit)
+			return -1.0f;
+		float height = startHeight + (endHeight - startHeight) * enter;	// Height changes linearly during the tick
+		if (height < clearance)
+			return enter;
+		if (endHeight < startHeight) {									// Falling - may drop below the clearance before the content is passed
+			float time = (startHeight - clearance) / (startHeight - endHeight);
+			if (time <= exit)
+				return time;
+		}
+		return -1.0f;
+	}
+};
+// -------------------- Namespace: Collision --------------------
+
+// -------------------- Class: EntityStore --------------------
+int EntityStore::kernel = -1;
+
+int EntityStore::add(int type, float posX, float posY, float posZ, int render) {
+	this->posX.push_back(posX);
+	this->posY.push_back(posY);
+	this->posZ.push_back(posZ);
+	types.push_back((unsigned char)type);
+	renders.push_back((unsigned char)render);
+	return size() - 1;
+}
+
+void EntityStore::reserve(int entities) {
+	posX.reserve(entities);
+	posY.reserve(entities);
+	posZ.reserve(entities);
+	types.reserve(entities);
+	renders.reserve(entities);
+}
+
+void EntityStore::release(float minX) {
+	int released = 0;
+	while (released < size() && posX[released] < minX)
+		released++;
+	posX.erase(posX.begin(), posX.begin() + released);
+	posY.erase(posY.begin(), posY.begin() + released);
+	posZ.erase(posZ.begin(), posZ.begin() + released);
+	types.erase(types.begin(), types.begin() + released);
+	renders.erase(renders.begin(), renders.begin() + released);
+}
+
+void EntityStore::clear() {
+	posX.clear();
+	posY.clear();
+	posZ.clear();
+	types.clear();
+	renders.clear();
+}
+
+int EntityStore::size() const {
+	return (int)posX.size();
+}
+
+void EntityStore::scroll(float distance, float minX, float hitX) {
+	int entities = size();
+	hits.assign((entities + 31) / 32, 0);
+	wraps.assign((entities + 31) / 32, 0);
+	if (entities > 0)
+		kernels[GetKernel()](posX.data(), 0, entities, distance, minX, hitX, hits.data(), wraps.data());
+}
+
+int EntityStore::findHit(int type) const {
+	for (int w = 0; w < (int)hits.size(); w++) {
+		unsigned long bits = hits[w], bit;
+		while (_BitScanForward(&bit, bits)) {							// Each entity within [-hitX, hitX]
+			if (types[w * 32 + bit] == type)
+				return w * 32 + bit;
+			bits &= bits - 1;
+		}
+	}
+	return -1;
+}
+
+float EntityStore::findImpact(int type, float distance, float hitX, float startHeight, float endHeight, float clearance, int* entity) const {
+	float impact = -1.0f;
+	for (int w = 0; w < (int)hits.size(); w++) {
+		unsigned long bits = hits[w], bit;
+		while (_BitScanForward(&bit, bits)) {							// Only the entities that have been next to the runner
+			int i = w * 32 + bit;
+			float time = types[i] == type ? Collision::Sweep(posX[i], distance, hitX, startHeight, endHeight, clearance) : -1.0f;
+			if (time >= 0.0f && (impact < 0.0f || time < impact)) {
+				impact = time;
+				if (entity != NULL)
+					*entity = i;
+			}
+			bits &= bits - 1;
+		}
+	}
+	return impact;
+}
+
+void EntityStore::SetKernel(int kernel) {
+	EntityStore::kernel = kernel > GetBestKernel() ? GetBestKernel() : kernel;
+}
+
+int EntityStore::GetKernel() {
+	if (kernel < 0)														// Not selected - use the best one
+		kernel = GetBestKernel();
+	return kernel;
+}
+
+int EntityStore::GetBestKernel() {
+	static int best = DetectKernel();
+	return best;
+}
+// -------------------- Class: EntityStore --------------------
+
+// -------------------- Class: ObstacleRing --------------------
+ObstacleRing::ObstacleRing() : offset(0.0f), head(0), count(0), cursor(0) {
+}
+
+void ObstacleRing::push(float posX, float posY, float posZ) {
+	if (count == (int)this->posX.size()) {								// Full - move to a buffer twice as large (obstacles are stored in order from slot 0)
+		int slots = count > 0 ? 2 * count : 16;
+		std::vector <float> x(slots), y(slots), z(slots);
+		for (int i = 0; i < count; i++) {
+			x[i] = this->posX[slot(i)];
+			y[i] = this->posY[slot(i)];
+			z[i] = this->posZ[slot(i)];
+		}
+		this->posX.swap(x);
+		this->posY.swap(y);
+		this->posZ.swap(z);
+		head = 0;
+	}
+	int tail = slot(count++);
+	this->posX[tail] = posX + offset;
+	this->posY[tail] = posY;
+	this->posZ[tail] = posZ;
+}
+
+void ObstacleRing::release(float minX) {
+	while (count > 0 && posX[head] - offset < minX) {					// Obstacles behind minX are always at the head
+		head = slot(1);
+		count--;
+		if (cursor > 0)
+			cursor--;
+	}
+}
+
+void ObstacleRing::clear() {
+	offset = 0.0f;
+	head = count = cursor = 0;
+}
+
+int ObstacleRing::size() const {
+	return count;
+}
+
+void ObstacleRing::scroll(float distance) {
+	offset += distance;
+	if (offset > 65536.0f) {											// Rebase before the offset loses precision
+		for (int i = 0; i < count; i++)
+			posX[slot(i)] -= offset;
+		offset = 0.0f;
+	}
+}
+
+float ObstacleRing::findImpact(float distance, float hitX, float startHeight, float endHeight, float clearance) {
+	float impact = -1.0f;
+	for (; cursor < count; cursor++) {
+		float x = posX[slot(cursor)] - offset;
+		if (x > hitX)													// Not reached yet - neither are the ones after it
+			break;
+		float time = Collision::Sweep(x, distance, hitX, startHeight, endHeight, clearance);
+		if (time >= 0.0f && (impact < 0.0f || time < impact))
+			impact = time;
+		if (x >= -hitX)													// Runner is next to it
+			break;
+	}																	// Passed obstacles are left behind the cursor
+	return impact;
+}
+
+float ObstacleRing::getPositionX(int i) const {
+	return posX[slot(i)] - offset;
+}
+
+float ObstacleRing::getPositionY(int i) const {
+	return posY[slot(i)];
+}
+
+float ObstacleRing::getPositionZ(int i) const {
+	return posZ[slot(i)];
+}
+// -------------------- Class: ObstacleRing --------------------
\ No newline at end of file
@@ -0,0 +1,104 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __ENTITIES__
+# define __ENTITIES__
+
+# include <cstddef>														// NULL
+# include <vector>														// Vector
+
+// -------------------- Namespace: Collision --------------------
+namespace Collision {													// Continuous collision between the runner & the content moving towards it
+	float Sweep(float endX, float distance, float hitX, float startHeight, float endHeight, float clearance);	// Time of impact in [0, 1] of a tick - -1 if none
+};
+// -------------------- Namespace: Collision --------------------
+
+// -------------------- Class: EntityStore --------------------
+class EntityStore {														// World content stored as structure of arrays - entity i is index i of every array
+public:
+	int add(int type, float posX, float posY, float posZ, int render);	// Add an entity - returns its index
+	void reserve(int entities);											// Allocate space for the given number of entities
+	void release(float minX);											// Remove the entities behind minX from the front (for content added in order of x)
+	void clear();														// Remove all entities
+	int size() const;													// Number of entities
+
+	void scroll(float distance, float minX, float hitX);				// Move all entities back by distance - the ones behind minX are re-added in front (posX = -posX)
+	int findHit(int type) const;										// First entity of the given type that swept through [-hitX, hitX] in the last scroll - -1 if none
+	float findImpact(int type, float distance, float hitX, float startHeight, float endHeight, float clearance, int* entity = NULL) const;	// Earliest time of impact in the last scroll (see Collision::Sweep) - -1 if none
+
+	const float* getPositionsX() const { return posX.data(); }
+	const float* getPositionsY() const { return posY.data(); }
+	const float* getPositionsZ() const { return posZ.data(); }
+	const unsigned char* getTypes() const { return types.data(); }
+	const unsigned char* getRenders() const { return renders.data(); }
+	const unsigned* getHits() const { return hits.data(); }				// Bitmask of the last scroll - bit i % 32 of word i / 32 is set if entity i has been within [-hitX, hitX] while moving
+	const unsigned* getWraps() const { return wraps.data(); }			// Bitmask of the last scroll - set if entity i was re-added in front
+
+	static void SetKernel(int kernel);									// Select the kernel used by scroll (falls back to the best supported one)
+	static int GetKernel();
+	static int GetBestKernel();											// Fastest kernel supported by this CPU (detected once)
+
+	enum Types { SCENERY, OBSTACLE };									// Type tag - how an entity takes part in the game
+	enum Kernels { SCALAR, SSE2, AVX, KERNELS };						// Implementations of scroll
+
+private:
+	std::vector <float> posX, posY, posZ;
+	std::vector <unsigned char> types;
+	std::vector <unsigned char> renders;								// Render handle - what is displayed for each entity (given by the Graphics Library)
+	std::vector <unsigned> hits, wraps;
+
+	static int kernel;
+};
+// -------------------- Class: EntityStore --------------------
+
+// -------------------- Class: ObstacleRing --------------------
+class ObstacleRing {													// Obstacles in a circular buffer ordered by x - they all move together, so scrolling only changes an offset
+public:
+	ObstacleRing();
+
+	void push(float posX, float posY, float posZ);						// Add an obstacle in front of all others
+	void release(float minX);											// Remove the obstacles behind minX
+	void clear();														// Remove all obstacles
+	int size() const;													// Number of obstacles
+
+	void scroll(float distance);										// Move all obstacles back by distance
+	float findImpact(float distance, float hitX, float startHeight, float endHeight, float clearance);	// Earliest time of impact in the last scroll - only the obstacles from the cursor on are checked
+
+	float getPositionX(int i) const;									// Position of the i-th obstacle (0: the one furthest behind)
+	float getPositionY(int i) const;
+	float getPositionZ(int i) const;
+
+private:
+	int slot(int i) const { return (head + i) % (int)posX.size(); }		// Slot of the i-th obstacle
+
+	std::vector <float> posX, posY, posZ;								// Slots of the buffer - posX is relative to offset
+	float offset;														// Distance all obstacles have moved
+	int head;															// Slot of the obstacle furthest behind
+	int count;															// Obstacles in the buffer
+	int cursor;															// Next obstacle ahead of the runner (i-th obstacle)
+};
+// -------------------- Class: ObstacleRing --------------------
+
+# endif  // # ifndef __ENTITIES__
\ No newline at end of file
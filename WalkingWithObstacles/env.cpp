@@ -0,0 +1,125 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include "env.h"
+# include "threadpool.h"
+
+// -------------------- Class: Env --------------------
+const float Env::HORIZON = 1000.0f;
+const float Env::HIT_PENALTY = 500.0f;
+
+Env::Env(int tick, int length) : simulation(0u), tick(tick), length(length) {
+	Observe(simulation, observation);
+}
+
+const Env::Observation& Env::reset(unsigned seed) {
+	simulation.reset(seed);
+	Observe(simulation, observation);
+	return observation;
+}
+
+Env::Result Env::step(int action) {
+	double traveled = simulation.getTraveled();
+	int events = simulation.step(Inputs(action), tick);
+	Observe(simulation, observation);
+	Result result;
+	result.observation = observation;
+	result.reward = Reward(simulation, traveled, events);
+	result.done = simulation.getTicks() >= length;
+	return result;
+}
+
+int Env::Inputs(int action) {
+	static const int inputs[ACTIONS] = { 0, Simulation::SPEED_UP, Simulation::SLOW_DOWN, Simulation::JUMP };
+	return action >= 0 && action < ACTIONS ? inputs[action] : 0;		// Unknown actions are no-ops
+}
+
+void Env::Observe(const Simulation& simulation, Observation& observation) {
+	const Motion& runner = simulation.getRunner();
+	const ObstacleRing& obstacles = simulation.getObstacles();
+	observation.speed = runner.getSpeed();
+	observation.height = runner.getHeight();
+	int next = 0;
+	for (int i = 0; i < obstacles.size() && next < OBSERVED; i++) {	// Ordered - skip the ones behind the runner
+		float distance = obstacles.getPositionX(i) - 5.0f;				// From the front of the runner
+		if (distance > 0.0f)
+			observation.obstacles[next++] = distance < HORIZON ? distance : HORIZON;
+	}
+	for (; next < OBSERVED; next++)
+		observation.obstacles[next] = HORIZON;
+	observation.hit = simulation.isHit() ? 1.0f : 0.0f;
+	observation.protect = simulation.isProtected() ? 1.0f : 0.0f;
+}
+
+float Env::Reward(const Simulation& simulation, double traveled, int events) {
+	float reward = (float)(simulation.getTraveled() - traveled);
+	if (events & Simulation::HIT)
+		reward -= HIT_PENALTY;
+	return reward;
+}
+// -------------------- Class: Env --------------------
+
+// -------------------- Class: Envs --------------------
+Envs::Envs(int count, int tick, int length) : observations(count), rewards(count, 0.0f), dones(count, 0), seeds(count, 0), tick(tick), length(length) {
+	simulations.reserve(count);
+	for (int i = 0; i < count; i++)
+		simulations.push_back(Simulation(0u));
+	reset(0);
+}
+
+void Envs::reset(unsigned seed) {
+	for (int i = 0; i < size(); i++) {
+		seeds[i] = seed + i;
+		simulations[i].reset(seeds[i]);
+		Env::Observe(simulations[i], observations[i]);
+		rewards[i] = 0.0f;
+		dones[i] = 0;
+	}
+}
+
+void Envs::step(const int* actions, ThreadPool* pool) {
+	if (pool == NULL || pool->getThreads() < 2) {
+		step(0, size(), actions);
+		return;
+	}
+	int blocks = 4 * pool->getThreads();								// A few blocks per thread - finished walks reset at uneven times
+	pool->parallelFor(0, size(), (size() + blocks - 1) / blocks, [this, actions](int first, int last) { step(first, last, actions); });
+}
+
+void Envs::step(int first, int last, const int* actions) {
+	for (int i = first; i < last; i++) {
+		Simulation& simulation = simulations[i];
+		double traveled = simulation.getTraveled();
+		int events = simulation.step(Env::Inputs(actions[i]), tick);
+		rewards[i] = Env::Reward(simulation, traveled, events);
+		dones[i] = simulation.getTicks() >= length;
+		if (dones[i]) {
+			seeds[i] += size();											// Walks never share a course
+			simulation.reset(seeds[i]);
+		}
+		Env::Observe(simulation, observations[i]);
+	}
+}
+// -------------------- Class: Envs --------------------
\ No newline at end of file
@@ -0,0 +1,104 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __ENV__
+# define __ENV__
+
+# include <vector>
+
+# include "simulation.h"
+
+class ThreadPool;
+
+// -------------------- Class: Env --------------------
+class Env {																// Walk driven by an agent - one action per tick, answered with what the runner sees & a reward
+public:
+	Env(int tick = 16, int length = 20000);								// Length of each tick (in milliseconds) & ticks of an episode
+
+	enum Actions { NOOP, SPEED_UP, SLOW_DOWN, JUMP, ACTIONS };
+
+	static const int OBSERVED = 3;										// Obstacles ahead in an observation
+	static const float HORIZON;											// Distance of obstacles not in sight
+	static const float HIT_PENALTY;										// Reward lost on a hit (about the distance lost standing still)
+
+	class Observation {													// Everything is a float - a batch of observations is a single float array
+	public:
+		float speed;
+		float height;
+		float obstacles[OBSERVED];										// Distance to the next obstacles (HORIZON if none)
+		float hit;														// 1: Standing still after a hit
+		float protect;													// 1: Hits are ignored
+	};
+
+	class Result {
+	public:
+		Observation observation;
+		float reward;													// Distance traveled in the tick - HIT_PENALTY if it was hit
+		bool done;														// Episode is over - reset before the next step
+	};
+
+	const Observation& reset(unsigned seed);							// Start an episode over the course of seed
+	Result step(int action);
+
+	const Simulation& getSimulation() const { return simulation; }
+
+	static int Inputs(int action);										// Simulation inputs of an action
+	static void Observe(const Simulation& simulation, Observation& observation);
+	static float Reward(const Simulation& simulation, double traveled, int events);	// Reward of a tick - traveled is the distance before it
+
+private:
+	Simulation simulation;
+	Observation observation;
+	int tick, length;
+};
+// -------------------- Class: Env --------------------
+
+// -------------------- Class: Envs --------------------
+class Envs {															// Many walks stepped by a single call - their state is kept in contiguous arrays
+public:
+	Envs(int count, int tick = 16, int length = 20000);
+
+	void reset(unsigned seed);											// Walk i starts over the course of seed + i
+	void step(const int* actions, ThreadPool* pool = NULL);				// One action per walk - finished walks are reset over their next course (seed + count)
+
+	int size() const { return (int)simulations.size(); }
+	const Env::Observation* getObservations() const { return &observations[0]; }	// Observation after the last step (of the new episode for the finished walks)
+	const float* getRewards() const { return &rewards[0]; }
+	const unsigned char* getDones() const { return &dones[0]; }			// 1: The walk finished in the last step
+	const Simulation& getSimulation(int i) const { return simulations[i]; }
+
+private:
+	void step(int first, int last, const int* actions);					// Step walks [first, last)
+
+	std::vector <Simulation> simulations;
+	std::vector <Env::Observation> observations;
+	std::vector <float> rewards;
+	std::vector <unsigned char> dones;
+	std::vector <unsigned> seeds;										// Course of each walk
+	int tick, length;
+};
+// -------------------- Class: Envs --------------------
+
+# endif  // # ifndef __ENV__
\ No newline at end of file
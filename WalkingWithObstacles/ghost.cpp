@@ -0,0 +1,152 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <algorithm>
+# include <cmath>
+# include <fstream>
+# include <iostream>
+# include <iterator>
+
+# include "ghost.h"
+# include "varint.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// File: "WWOG", version, runner, ticks, time & distance - then the samples: per channel the change of its delta (zigzag varint)
+// Time & distance grow by about the same amount & the arms/legs swing at a steady rate, so most changes are small - a byte per channel
+static const char magic[4] = { 'W', 'W', 'O', 'G' };
+static const unsigned char version = 2;									// 2: samples have the time they were at
+static const float scales[] = { 1.0f, 100.0f, 10.0f, 10.0f, 10.0f };	// Fixed point of each channel
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Class: GhostTrack --------------------
+GhostTrack::GhostTrack() : character(0), ticks(0), time(0), traveled(0.0) {
+	std::fill(last, last + CHANNELS, 0);
+	std::fill(delta, delta + CHANNELS, 0);
+	data.reserve(65536);												// About 15 minutes of a walk before growing
+	rewind();
+}
+
+void GhostTrack::record(int tick, double traveled, const Motion& runner) {
+	time += tick;
+	if (ticks++ % INTERVAL == 0) {
+		double values[CHANNELS] = { (double)time, traveled, runner.getHeight(), runner.getRotationH(), runner.getRotationL() };
+		for (int i = 0; i < CHANNELS; i++) {
+			int fixed = (int)floor(values[i] * scales[i] + 0.5);
+			int d = fixed - last[i];
+			Varint::Write(data, Varint::ZigZag(d - delta[i]));
+			delta[i] = d;
+			last[i] = fixed;
+		}
+	}
+	this->traveled = traveled;
+}
+
+void GhostTrack::rewind() {
+	cursor = 0;
+	played = 0;
+	over = false;
+	std::fill(value, value + CHANNELS, 0);
+	std::fill(change, change + CHANNELS, 0);
+	std::fill(next, next + CHANNELS, 0);
+	decode();															// previous: first sample, next: second one
+	decode();
+}
+
+bool GhostTrack::play(int tick, double& traveled, Motion& pose) {
+	if (played >= time)
+		return false;
+	played += tick;														// By time - the ticks of this walk needn't be those of the recorded one
+	while (!over && next[TIME] < played)								// Passed the next sample
+		decode();
+	int span = next[TIME] - previous[TIME];
+	float t = span > 0 ? (float)(played - previous[TIME]) / span : 0.0f, values[CHANNELS];
+	t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;							// Before the first sample or after the last one - held
+	for (int i = 0; i < CHANNELS; i++)
+		values[i] = (previous[i] + (next[i] - previous[i]) * t) / scales[i];
+	traveled = previous[TRAVELED] / (double)scales[TRAVELED] + (next[TRAVELED] - previous[TRAVELED]) * t / scales[TRAVELED];	// In double - distance grows large
+	pose = Motion(0.0f, values[HEIGHT], values[ROTATION_H], values[ROTATION_L]);
+	return true;
+}
+
+void GhostTrack::decode() {
+	std::copy(next, next + CHANNELS, previous);
+	if (over)
+		return;
+	unsigned cursor = this->cursor, zigzag;
+	for (int i = 0; i < CHANNELS; i++)
+		if (!Varint::Read(data, cursor, zigzag)) {						// Track is over - the last sample is held
+			over = true;
+			return;
+		}
+		else {
+			change[i] += Varint::UnZigZag(zigzag);
+			value[i] += change[i];
+			next[i] = value[i];
+		}
+	this->cursor = cursor;
+}
+
+bool GhostTrack::load(std::string file) {
+	std::ifstream input(file, std::ios::binary);
+	if (!input.is_open())
+		return false;
+	std::vector <unsigned char> bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	unsigned cursor = sizeof(magic) + 1, kind = 0, count = 0, elapsed = 0, distance = 0;
+	if (bytes.size() < cursor || !std::equal(magic, magic + sizeof(magic), bytes.begin()) || bytes[sizeof(magic)] != version
+		|| !Varint::Read(bytes, cursor, kind) || !Varint::Read(bytes, cursor, count) || !Varint::Read(bytes, cursor, elapsed) || !Varint::Read(bytes, cursor, distance)) {
+		std::cerr << "Not a ghost: " << file << std::endl;
+		return false;
+	}
+	data.assign(bytes.begin() + cursor, bytes.end());
+	character = (int)kind;
+	ticks = count;
+	time = elapsed;
+	traveled = distance / (double)scales[TRAVELED];
+	rewind();
+	std::cout << "Loaded ghost: " << file << " (" << ticks << " ticks in " << data.size() << " bytes)" << std::endl;
+	return true;
+}
+
+bool GhostTrack::save(std::string file) const {
+	std::vector <unsigned char> header(magic, magic + sizeof(magic));
+	header.push_back(version);
+	Varint::Write(header, (unsigned)character);
+	Varint::Write(header, (unsigned)ticks);
+	Varint::Write(header, (unsigned)time);
+	Varint::Write(header, (unsigned)floor(traveled * scales[TRAVELED] + 0.5));
+	std::ofstream output(file, std::ios::binary);
+	if (!output.is_open()) {
+		std::cerr << "Cannot write ghost: " << file << std::endl;
+		return false;
+	}
+	output.write((const char*)&header[0], header.size());
+	if (!data.empty())
+		output.write((const char*)&data[0], data.size());
+	std::cout << "Saved ghost: " << file << " (" << ticks << " ticks in " << data.size() << " bytes)" << std::endl;
+	return true;
+}
+// -------------------- Class: GhostTrack --------------------
\ No newline at end of file
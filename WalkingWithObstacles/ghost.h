@@ -0,0 +1,74 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __GHOST__
+# define __GHOST__
+
+# include <string>
+# include <vector>
+
+# include "simulation.h"
+
+// -------------------- Class: GhostTrack --------------------
+class GhostTrack {														// Time, distance, height & pose of a runner every few ticks - stored as varints of the change of each delta
+public:
+	GhostTrack();
+
+	void record(int tick, double traveled, const Motion& runner);		// Add the next tick of tick milliseconds - every INTERVAL-th one is kept
+	void rewind();														// Play from the start
+	bool play(int tick, double& traveled, Motion& pose);				// tick milliseconds later (interpolated between the kept ticks by time) - false: track is over
+
+	bool load(std::string file);										// Read track from file - false if it can't be read
+	bool save(std::string file) const;
+
+	double getTraveled() const { return traveled; }						// Distance at the last recorded tick
+	long long getTicks() const { return ticks; }
+	long long getTime() const { return time; }							// Time of the last recorded tick (in milliseconds)
+	int getCharacter() const { return character; }
+	void setCharacter(int character) { this->character = character; }
+	size_t getBytes() const { return data.size(); }
+
+	static const int INTERVAL = 4;										// Ticks between kept samples
+
+private:
+	enum Channels { TIME, TRAVELED, HEIGHT, ROTATION_H, ROTATION_L, CHANNELS };	// Fixed point values (see scales)
+
+	void decode();														// Read the next sample into next
+
+	std::vector <unsigned char> data;
+	int character;
+	long long ticks;
+	long long time;
+	double traveled;
+	int last[CHANNELS], delta[CHANNELS];								// Last sample written & its deltas
+	unsigned cursor;													// Next byte to decode
+	int value[CHANNELS], change[CHANNELS];								// Last sample decoded & its deltas
+	int previous[CHANNELS], next[CHANNELS];								// Samples played between
+	long long played;													// Time played (in milliseconds)
+	bool over;															// No samples left to decode
+};
+// -------------------- Class: GhostTrack --------------------
+
+# endif  // # ifndef __GHOST__
\ No newline at end of file
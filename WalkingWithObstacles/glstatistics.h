@@ -0,0 +1,72 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+# ifndef __GLSTATISTICS__
+# define __GLSTATISTICS__
+
+// Wrappers counting the OpenGL calls of each frame into Statistics (has to be included after gl\glut.h)
+// Each wrapper expands to the original call - a function-like macro is never expanded again inside itself
+// The calls compiled into a display list are recorded once and counted again whenever the list is called
+// GLU/GLUT primitives are estimated by their wrappers - a draw call per stack (loop, ring) & a strip of vertices around it
+
+# include "gl\glut.h"
+# include "utilities.h"
+
+// -------------------- Draw calls & vertices --------------------
+# define glBegin(mode) (Statistics::Count(Statistics::DRAW_CALLS), glBegin(mode))
+# define glVertex3f(x, y, z) (Statistics::Count(Statistics::VERTICES), glVertex3f(x, y, z))
+# define glVertex4f(x, y, z, w) (Statistics::Count(Statistics::VERTICES), glVertex4f(x, y, z, w))
+# define glRectf(x1, y1, x2, y2) (Statistics::Count(Statistics::DRAW_CALLS), Statistics::Count(Statistics::VERTICES, 4), glRectf(x1, y1, x2, y2))
+# define gluSphere(quadric, radius, slices, stacks) (Statistics::Count(Statistics::DRAW_CALLS, (unsigned long)(stacks)), \
+	Statistics::Count(Statistics::VERTICES, (unsigned long)(2 * ((slices) + 1) * (stacks))), gluSphere(quadric, radius, slices, stacks))
+# define gluCylinder(quadric, base, top, height, slices, stacks) (Statistics::Count(Statistics::DRAW_CALLS, (unsigned long)(stacks)), \
+	Statistics::Count(Statistics::VERTICES, (unsigned long)(2 * ((slices) + 1) * (stacks))), gluCylinder(quadric, base, top, height, slices, stacks))
+# define gluDisk(quadric, inner, outer, slices, loops) (Statistics::Count(Statistics::DRAW_CALLS, (unsigned long)(loops)), \
+	Statistics::Count(Statistics::VERTICES, (unsigned long)(2 * ((slices) + 1) * (loops))), gluDisk(quadric, inner, outer, slices, loops))
+# define glutSolidTorus(inner, outer, sides, rings) (Statistics::Count(Statistics::DRAW_CALLS, (unsigned long)(rings)), \
+	Statistics::Count(Statistics::VERTICES, (unsigned long)(2 * ((sides) + 1) * (rings))), glutSolidTorus(inner, outer, sides, rings))
+# define glutStrokeCharacter(font, character) (Statistics::Count(Statistics::DRAW_CALLS), glutStrokeCharacter(font, character))
+# define glCallList(list) (Statistics::CallList(list), glCallList(list))
+# define glCallLists(n, type, lists) (Statistics::Count(Statistics::DRAW_CALLS), glCallLists(n, type, lists))
+# define glDrawArrays(mode, first, count) (Statistics::Count(Statistics::DRAW_CALLS), Statistics::Count(Statistics::VERTICES, (unsigned long)(count)), glDrawArrays(mode, first, count))
+// -------------------- Draw calls & vertices --------------------
+
+// -------------------- Display lists --------------------
+# define glNewList(list, mode) (Statistics::BeginList(list, (mode) == GL_COMPILE_AND_EXECUTE), glNewList(list, mode))
+# define glEndList() (glEndList(), Statistics::EndList())
+# define glDeleteLists(list, range) (Statistics::DeleteLists(list, range), glDeleteLists(list, range))
+// -------------------- Display lists --------------------
+
+// -------------------- State changes --------------------
+# define glBindTexture(target, texture) (Statistics::Count(Statistics::TEXTURE_BINDS), glBindTexture(target, texture))
+# define glMaterialf(face, pname, param) (Statistics::Count(Statistics::MATERIAL_CHANGES), glMaterialf(face, pname, param))
+# define glMateriali(face, pname, param) (Statistics::Count(Statistics::MATERIAL_CHANGES), glMateriali(face, pname, param))
+# define glMaterialfv(face, pname, params) (Statistics::Count(Statistics::MATERIAL_CHANGES), glMaterialfv(face, pname, params))
+# define glPushMatrix() (Statistics::Count(Statistics::MATRIX_PUSHES), glPushMatrix())
+# define glPopMatrix() (Statistics::Count(Statistics::MATRIX_POPS), glPopMatrix())
+# define glEnable(capability) (Statistics::Count(Statistics::STATE_TOGGLES), glEnable(capability))
+# define glDisable(capability) (Statistics::Count(Statistics::STATE_TOGGLES), glDisable(capability))
+// -------------------- State changes --------------------
+
+# endif  // # ifndef __GLSTATISTICS__
\ No newline at end of file
@@ -22,12 +22,18 @@
 */
 
 
+# include <cmath>
+# include <cstdio>
 # include <ctime>
 # include <sstream>
 
 # include "graphics.h"
 # include "utilities.h"
 # include "application.h"
+# include "pool.h"
+# include "glstatistics.h"
+# include "replay.h"
+# include "threadpool.h"
 
 // -------------------- Static content - to be used only in this file -------------------
 
@@ -36,11 +42,23 @@ using namespace Graphics;
 static GLfloat zFar = 5000.0;
 
 static GLUquadric* quadric;
-static class Graphics* graphics;
-static class World* lastRace = NULL;
 
 static GLfloat specref[4];
 
+static double renderTime = 0.0;											// Time spent displaying the last frame (in milliseconds)
+
+static const char* worldTextures[] = { "cave", "sand", "sea", "lilipad", "path", "gold", "green", "wood", "metal" };	// Textures of the World & its objects
+static bool preloaded = false;											// The World's assets are kept loaded for the next walks
+static Course* nextCourse = NULL;										// Course of the next walk - generated while the player is in the menus
+
+static const char* ghostFile = "ghost.dat";								// Best walk so far - replaced when a walk goes further
+static int crowdRunners = 0;											// AI runners of the next walks
+static GLubyte halftone[128];											// Stipple pattern - every other pixel of the ghost is drawn
+
+static unsigned NextSeed() {											// Seed of the next course - a replay repeats the course it was recorded on
+	return Replay::IsReplaying() ? Replay::GetSeed() : (unsigned)rand();
+}
+
 // -------------------- Static content - to be used only in this file -------------------
 
 // -------------------- Class: Camera --------------------
@@ -96,13 +114,67 @@ void Camera::place() const {											// Place camera in the scene
 	glRotatef(angleY, 0.0, 1.0, 0.0);									// Rotate scene around the Y axis
 	glTranslatef(centerX, centerY, centerZ);
 }
+
+void Camera::getPosition(GLfloat& x, GLfloat& y, GLfloat& z) const {	// Position of the camera in the scene (where place puts the eye)
+	GLfloat aX = angleX * 3.14159265 / 180.0, aY = angleY * 3.14159265 / 180.0;
+	x = distance * cos(aX) * sin(aY) - centerX;							// The eye taken back through the rotations & translations of place
+	y = -distance * sin(aX) - centerY;
+	z = -distance * cos(aX) * cos(aY) - centerZ;
+}
 // -------------------- Class: Camera --------------------
 
+// -------------------- Class: Detail --------------------
+const GLint Detail::details[LEVELS] = { 30, 20, 12, 8, 5 };
+const GLfloat Detail::sizes[LEVELS - 1] = { 120.0, 60.0, 25.0, 10.0 };
+const GLfloat Detail::HYSTERESIS = 0.15f;
+GLfloat Detail::pixelsPerUnit = 600.0 / (2.0 * tan(30.0 * 3.14159265 / 180.0));	// Until the first reshape
+GLfloat Detail::eye[3] = { 0.0, 0.0, 0.0 };
+
+Detail::Detail() : level(0) {
+}
+
+GLint Detail::select(GLfloat radius, GLfloat posX, GLfloat posY, GLfloat posZ) {
+	GLfloat distance = Distance(posX, posY, posZ);						// From the camera to the object's origin - no query of the pipeline
+	GLfloat size = distance > 1.0f ? radius / distance * pixelsPerUnit : sizes[0] * 2.0f;
+	while (level > 0 && size >= sizes[level - 1] * (1.0f + HYSTERESIS))	// Finer
+		level--;
+	while (level < LEVELS - 1 && size < sizes[level] * (1.0f - HYSTERESIS))	// Coarser
+		level++;
+	return details[level];
+}
+
+int Detail::getLevel() const {
+	return level;
+}
+
+void Detail::SetViewport(int height) {
+	pixelsPerUnit = height / (2.0 * tan(30.0 * 3.14159265 / 180.0));	// Field of view of 60 degrees
+}
+
+void Detail::SetEye(GLfloat x, GLfloat y, GLfloat z) {
+	eye[0] = x;
+	eye[1] = y;
+	eye[2] = z;
+}
+
+const GLfloat* Detail::GetEye() {
+	return eye;
+}
+
+GLfloat Detail::Distance(GLfloat posX, GLfloat posY, GLfloat posZ) {
+	return sqrt((posX - eye[0]) * (posX - eye[0]) + (posY - eye[1]) * (posY - eye[1]) + (posZ - eye[2]) * (posZ - eye[2]));
+}
+
+GLint Detail::GetDetail(int level) {
+	return details[level];
+}
+// -------------------- Class: Detail --------------------
+
 // -------------------- !! BEGIN: ALL IMPLEMENTATIONS OF CLASS CHARACTER !! --------------------
 
 // -------------------- Class: Runner --------------------
-Runner::Runner() : speed(15.0), speedChange(2.0), minSpeed(8.0), maxSpeed(25.0), move(RIGHT_ARM_FRONT),
-height(0.0), rotationH(0.0), rotationL(0.0) {
+Runner::Runner() : fixedDetail(0) {
+	position[0] = position[1] = position[2] = 0.0;
 	Audio::Load("step");
 	Audio::SetVolume("step", 0.6);
 	Audio::Load("fall");
@@ -114,120 +186,26 @@ Runner::~Runner() {
 }
 
 void Runner::animate() {												// Animate Runner
-	static double speedFactorR = 35.0, speedFactorJ = speedFactorR*4.0;
-	if (move == RIGHT_ARM_FRONT) {
-		rotationH += speed * Timer::GetElapsedTime() / speedFactorR;
-		if (rotationL > 0.0)
-			rotationL -= speed * Timer::GetElapsedTime() / speedFactorR;
-		if (rotationH >= 45.0 + speed) {
-			move = LEFT_ARM_FRONT;
-			Audio::Play("step");
-		}
-	}
-	else if (move == LEFT_ARM_FRONT) {
-		rotationH -= speed * Timer::GetElapsedTime() / speedFactorR;
-		if (rotationL < 45.0)
-			rotationL += speed * Timer::GetElapsedTime() / speedFactorR;
-		if (rotationH <= -45.0 - speed) {
-			move = RIGHT_ARM_FRONT;
-			Audio::Play("step");
-		}
-	}
-	else if (move == JUMP_UP_RIGHT_ARM_FRONT) {
-		height += speed * Timer::GetElapsedTime() / (speedFactorJ);
-		rotationH += speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationL > 0.0)
-			rotationL -= speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationH >= 45.0 + speed)
-			move = JUMP_UP_LEFT_ARM_FRONT;
-		if (height >= jumpHeight)
-			if (move == JUMP_UP_LEFT_ARM_FRONT)
-				move = JUMP_DOWN_LEFT_ARM_FRONT;
-			else
-				move = JUMP_DOWN_RIGHT_ARM_FRONT;
-	}
-	else if (move == JUMP_UP_LEFT_ARM_FRONT) {
-		height += speed * Timer::GetElapsedTime() / (speedFactorJ);
-		rotationH -= speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationL < 45.0)
-			rotationL += speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationH <= -45.0 - speed)
-			move = JUMP_UP_RIGHT_ARM_FRONT;
-		if (height >= jumpHeight)
-			if (move == JUMP_UP_LEFT_ARM_FRONT)
-				move = JUMP_DOWN_LEFT_ARM_FRONT;
-			else
-				move = JUMP_DOWN_RIGHT_ARM_FRONT;
-	}
-	else if (move == JUMP_DOWN_RIGHT_ARM_FRONT) {
-		height -= speed * Timer::GetElapsedTime() / (speedFactorJ);
-		rotationH += speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationL > 0.0)
-			rotationL -= speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationH >= 45.0 + speed)
-			move = JUMP_DOWN_LEFT_ARM_FRONT;
-		if (height < 0.0) {
-			if (move == JUMP_DOWN_LEFT_ARM_FRONT)
-				move = LEFT_ARM_FRONT;
-			else
-				move = RIGHT_ARM_FRONT;
-			height = 0.0;
-			Audio::Play("fall");
-		}
-	}
-	else if (move == JUMP_DOWN_LEFT_ARM_FRONT) {
-		height -= speed * Timer::GetElapsedTime() / (speedFactorJ);
-		rotationH -= speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationL < 45.0)
-			rotationL += speed * Timer::GetElapsedTime() / speedFactorJ;
-		if (rotationH <= -45.0 - speed)
-			move = JUMP_DOWN_RIGHT_ARM_FRONT;
-		if (height < 0.0) {
-			if (move == JUMP_DOWN_LEFT_ARM_FRONT)
-				move = LEFT_ARM_FRONT;
-			else
-				move = RIGHT_ARM_FRONT;
-			height = 0.0;
-			Audio::Play("fall");
-		}
-	}
+	PROFILE_ZONE("Runner::animate");
+	int events = motion.step(Timer::GetElapsedTime());
+	if (events & Simulation::STEP)
+		Audio::Play("step");
+	if (events & Simulation::LAND)
+		Audio::Play("fall");
 }
 
-void Runner::speedUp() {												// Increase runners speed
-	if (move == LEFT_ARM_FRONT || move == RIGHT_ARM_FRONT) {
-		speed += speedChange;
-		if (speed > maxSpeed)
-			speed = maxSpeed;
-	}
+void Runner::setMotion(const Motion& motion) {
+	this->motion = motion;
 }
 
-void Runner::slowDown() {												// Decrease runners speed
-	if (move == LEFT_ARM_FRONT || move == RIGHT_ARM_FRONT) {
-		speed -= speedChange;
-		if (speed < minSpeed)
-			speed = minSpeed;
-	}
+void Runner::setPosition(GLfloat x, GLfloat y, GLfloat z) {
+	position[0] = x;
+	position[1] = y;
+	position[2] = z;
 }
 
-void Runner::jump() {													// Makes runner jump
-	if (move == LEFT_ARM_FRONT) {
-		move = JUMP_UP_LEFT_ARM_FRONT;
-		jumpHeight = 5.0*speed;
-	}
-	else if (move == RIGHT_ARM_FRONT) {
-		jumpHeight = 5.0*speed;
-		move = JUMP_UP_RIGHT_ARM_FRONT;
-	}
-	if (jumpHeight > 80.0)
-		jumpHeight = 80.0;
-}
-
-GLfloat Runner::getSpeed() const {
-	return speed;
-}
-
-GLfloat Runner::getHeight() const {
-	return height;
+GLint Runner::getDetail() const {
+	return fixedDetail > 0 ? fixedDetail : lod.select(40.0, position[0], position[1], position[2]);	// About the size of every runner
 }
 // -------------------- Class: Runner --------------------
 
@@ -247,7 +225,7 @@ public:
 	}
 
 	virtual void display() const {										// Display Human
-		GLint detail = 30;
+		GLint detail = getDetail();
 		Texture::Use("skin");
 		specref[0] = 0.2; specref[1] = 0.2; specref[2] = 0.2; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
@@ -259,7 +237,7 @@ public:
 		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
 		glMaterialf(GL_FRONT, GL_SHININESS, 25.6);
 		glPushMatrix();
-		glTranslatef(0.0, height + 37.0, -50.0);
+		glTranslatef(0.0, motion.getHeight() + 37.0, -50.0);
 		glRotatef(90.0, 0.0, 1.0, 0.0);
 		// Display Body
 		glPushMatrix();
@@ -324,13 +302,13 @@ public:
 		glPushMatrix();
 		glTranslatef(-3.5, -15.0, 0.0);
 		gluSphere(quadric, 2.5, detail, detail);
-		glRotatef(90.0 + rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 + motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		// Display right leg/foot half-low part
 		glTranslatef(0.0, 0.3, 10.0);
 		gluSphere(quadric, 2.0, detail, detail);
 		glTranslatef(0.0, -0.3, 0.0);
-		glRotatef(rotationL, 1.0, 0.0, 0.0);
+		glRotatef(motion.getRotationL(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -348,13 +326,13 @@ public:
 		glPushMatrix();
 		glTranslatef(3.5, -15.0, 0.0);
 		gluSphere(quadric, 2.5, detail, detail);
-		glRotatef(90.0 - rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 - motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		// Display left leg/foot half-low part
 		glTranslatef(0.0, 0.3, 10.0);
 		gluSphere(quadric, 2.0, detail, detail);
 		glTranslatef(0.0, -0.3, 0.0);
-		glRotatef(-rotationL + 45, 1.0, 0.0, 0.0);
+		glRotatef(-motion.getRotationL() + 45, 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -373,13 +351,13 @@ public:
 		glTranslatef(12.0, 5.0, 0.0);
 		gluSphere(quadric, 3.0, detail, detail);
 		glTranslatef(0.0, -1.0, 0.0);
-		glRotatef(90.0 - rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 - motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, -0.2, 10.0);
 		gluSphere(quadric, 2.1, detail, detail);
 		glTranslatef(0.0, 0.2, 0.0);
 		// Display right arm/hand half-low part
-		glRotatef(rotationL - 45, 1.0, 0.0, 0.0);
+		glRotatef(motion.getRotationL() - 45, 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -389,13 +367,13 @@ public:
 		glTranslatef(-12.0, 5.0, 0.0);
 		gluSphere(quadric, 3.0, detail, detail);
 		glTranslatef(0.0, -1.0, 0.0);
-		glRotatef(90.0 + rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 + motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, -0.2, 10.0);
 		gluSphere(quadric, 2.1, detail, detail);
 		glTranslatef(0.0, 0.2, 0.0);
 		// Display left arm/hand half-low part
-		glRotatef(-rotationL, 1.0, 0.0, 0.0);
+		glRotatef(-motion.getRotationL(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -404,10 +382,8 @@ public:
 		glPopMatrix();
 	}
 
-	static void display(int which_hand) {
-		GLint detail = 30;
-		Texture::Load("gold");
-		Texture::Use("gold");
+	static void UseMaterial(int part) {									// Texture & material of the parts of the statues (see Parts)
+		Texture::Use(part == GOLD_PARTS ? "gold" : "black");
 		specref[0] = 0.2; specref[1] = 0.2; specref[2] = 0.2; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
 		specref[0] = 0.8; specref[1] = 0.8; specref[2] = 0.8; specref[3] = 1.0;
@@ -417,9 +393,32 @@ public:
 		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
 		glMaterialf(GL_FRONT, GL_SHININESS, 25.6);
+	}
+
+	static void display(int which_hand, GLint detail, int part) {		// A material of a statue - "gold" & "black" are kept loaded by the World
 		glPushMatrix();
 		glTranslatef(0.0, 90.0, 0.0);
 		glRotatef(90.0, 0.0, 1.0, 0.0);
+		if (part == BLACK_PARTS) {
+			// right eye
+			glPushMatrix();
+			glTranslatef(-3.0, 27.0, 6.0);
+			gluSphere(quadric, 2.0, detail, detail);
+			glPopMatrix();
+			// left eye
+			glPushMatrix();
+			glTranslatef(3.0, 27.0, 6.0);
+			gluSphere(quadric, 2.0, detail, detail);
+			glPopMatrix();
+			// mouth
+			glPushMatrix();
+			glTranslatef(0.0, 14.0, 8.0);
+			glScalef(3.0, 2.0, 1.0);
+			gluSphere(quadric, 2.0, detail, detail);
+			glPopMatrix();
+			glPopMatrix();
+			return;
+		}
 		// Display Body
 		glPushMatrix();
 		glScalef(1.0, 1.2, 1.0);
@@ -437,42 +436,6 @@ public:
 		glScalef(1.0, 2.0, 1.0);
 		gluSphere(quadric, 10.0, detail, detail);
 		glPopMatrix();
-		Texture::Use("black");
-		specref[0] = 0.2; specref[1] = 0.2; specref[2] = 0.2; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
-		specref[0] = 0.8; specref[1] = 0.8; specref[2] = 0.8; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_DIFFUSE, specref);
-		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_SPECULAR, specref);
-		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
-		glMaterialf(GL_FRONT, GL_SHININESS, 25.6);
-		// right eye
-		glPushMatrix();
-		glTranslatef(-3.0, 27.0, 6.0);
-		gluSphere(quadric, 2.0, detail, detail);
-		glPopMatrix();
-		// left eye
-		glPushMatrix();
-		glTranslatef(3.0, 27.0, 6.0);
-		gluSphere(quadric, 2.0, detail, detail);
-		glPopMatrix();
-		// mouth
-		glPushMatrix();
-		glTranslatef(0.0, 14.0, 8.0);
-		glScalef(3.0, 2.0, 1.0);
-		gluSphere(quadric, 2.0, detail, detail);
-		glPopMatrix();
-		Texture::Use("gold");
-		specref[0] = 0.2; specref[1] = 0.2; specref[2] = 0.2; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
-		specref[0] = 0.8; specref[1] = 0.8; specref[2] = 0.8; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_DIFFUSE, specref);
-		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_SPECULAR, specref);
-		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
-		glMaterialf(GL_FRONT, GL_SHININESS, 25.6);
 		// nose
 		glPushMatrix();
 		glTranslatef(0.0, 21.0, 10.0);
@@ -562,7 +525,6 @@ public:
 		gluSphere(quadric, 2.2, detail, detail);
 		glPopMatrix();
 		glPopMatrix();
-		glPopMatrix();
 	}
 
 	int getKindOf() const {
@@ -570,6 +532,7 @@ public:
 	}
 
 	enum states { STATUE_LEFT_HAND, STATUE_RIGHT_HAND };
+	enum Parts { GOLD_PARTS, BLACK_PARTS };								// Statues are displayed a material at a time
 };
 // -------------------- Class: HumanRunner --------------------
 
@@ -587,7 +550,7 @@ public:
 	}
 
 	virtual void display() const {
-		GLint detail = 30;
+		GLint detail = getDetail();
 		Texture::Use("banana_skin");
 		specref[0] = 0.2; specref[1] = 0.2; specref[2] = 0.2; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
@@ -599,7 +562,7 @@ public:
 		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
 		glMaterialf(GL_FRONT, GL_SHININESS, 25.6);
 		glPushMatrix();
-		glTranslatef(0.0, height + 37.0, -50.0);
+		glTranslatef(0.0, motion.getHeight() + 37.0, -50.0);
 		glRotatef(90.0, 0.0, 1.0, 0.0);
 		// Display body-head
 		glPushMatrix();
@@ -652,13 +615,13 @@ public:
 		// Display right leg/foot half-hight part
 		glPushMatrix();
 		glTranslatef(-4.0, -15.0, 0.0);
-		glRotatef(90.0 + rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 + motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		// Display right leg/foot half-low part
 		glTranslatef(0.0, 0.3, 10.0);
 		gluSphere(quadric, 2.0, detail, detail);
 		glTranslatef(0.0, -0.3, 0.0);
-		glRotatef(rotationL, 1.0, 0.0, 0.0);
+		glRotatef(motion.getRotationL(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -675,13 +638,13 @@ public:
 		// Display left leg/foot half-hight part
 		glPushMatrix();
 		glTranslatef(4.0, -15.0, 0.0);
-		glRotatef(90.0 - rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 - motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		// Display left leg/foot half-low part
 		glTranslatef(0.0, 0.3, 10.0);
 		gluSphere(quadric, 2.0, detail, detail);
 		glTranslatef(0.0, -0.3, 0.0);
-		glRotatef(-rotationL + 45, 1.0, 0.0, 0.0);
+		glRotatef(-motion.getRotationL() + 45, 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -700,13 +663,13 @@ public:
 		glTranslatef(11.0, 5.0, 0.0);
 		gluSphere(quadric, 3.0, detail, detail);
 		glTranslatef(0.0, -1.0, 0.0);
-		glRotatef(90.0 - rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 - motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, -0.2, 10.0);
 		gluSphere(quadric, 2.1, detail, detail);
 		glTranslatef(0.0, 0.2, 0.0);
 		// Display right arm/hand half-low part
-		glRotatef(rotationL - 45, 1.0, 0.0, 0.0);
+		glRotatef(motion.getRotationL() - 45, 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -716,13 +679,13 @@ public:
 		glTranslatef(-11.0, 5.0, 0.0);
 		gluSphere(quadric, 3.0, detail, detail);
 		glTranslatef(0.0, -1.0, 0.0);
-		glRotatef(90.0 + rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 + motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, -0.2, 10.0);
 		gluSphere(quadric, 2.1, detail, detail);
 		glTranslatef(0.0, 0.2, 0.0);
 		// Display left arm/hand half-low part
-		glRotatef(-rotationL, 1.0, 0.0, 0.0);
+		glRotatef(-motion.getRotationL(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -749,7 +712,7 @@ public:
 	}
 
 	virtual void display() const {
-		GLint detail = 30;
+		GLint detail = getDetail();
 		Texture::Use("gold");
 		specref[0] = 0.105882; specref[1] = 0.058824; specref[2] = 0.113725; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
@@ -761,7 +724,7 @@ public:
 		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
 		glMaterialf(GL_FRONT, GL_SHININESS, 9.84615);
 		glPushMatrix();
-		glTranslatef(0.0, height + 38.0, -50.0);
+		glTranslatef(0.0, motion.getHeight() + 38.0, -50.0);
 		glRotatef(90.0, 0.0, 1.0, 0.0);
 		// Display body-head
 		// head
@@ -798,13 +761,13 @@ public:
 		glPushMatrix();
 		glTranslatef(-6.0, -15.0, 0.0);
 		gluSphere(quadric, 2.5, 25.0, 25.0);
-		glRotatef(90.0 + rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 + motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		// Display right leg/foot half-low part
 		glTranslatef(0.0, 0.3, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
 		glTranslatef(0.0, -0.3, 0.0);
-		glRotatef(rotationL, 1.0, 0.0, 0.0);
+		glRotatef(motion.getRotationL(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.5);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -822,13 +785,13 @@ public:
 		glPushMatrix();
 		glTranslatef(6.0, -15.0, 0.0);
 		gluSphere(quadric, 2.5, detail, detail);
-		glRotatef(90.0 - rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 - motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		// Display left leg/foot half-low part
 		glTranslatef(0.0, 0.3, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
 		glTranslatef(0.0, -0.3, 0.0);
-		glRotatef(-rotationL + 45, 1.0, 0.0, 0.0);
+		glRotatef(-motion.getRotationL() + 45, 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.5);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -846,13 +809,13 @@ public:
 		// Display right arm/hand half-hight part
 		glTranslatef(10.0, 6.5, 0.0);
 		gluSphere(quadric, 2.2, detail, detail);
-		glRotatef(90.0 - rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 - motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, -0.2, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
 		glTranslatef(0.0, 0.2, 0.0);
 		// Display right arm/hand half-low part
-		glRotatef(rotationL - 45, 1.0, 0.0, 0.0);
+		glRotatef(motion.getRotationL() - 45, 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -861,13 +824,13 @@ public:
 		// Display left arm/hand half-hight part
 		glTranslatef(-10.0, 6.5, 0.0);
 		gluSphere(quadric, 2.2, detail, detail);
-		glRotatef(90.0 + rotationH, 1.0, 0.0, 0.0);
+		glRotatef(90.0 + motion.getRotationH(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, -0.2, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
 		glTranslatef(0.0, 0.2, 0.0);
 		// Display left arm/hand half-low part
-		glRotatef(-rotationL, 1.0, 0.0, 0.0);
+		glRotatef(-motion.getRotationL(), 1.0, 0.0, 0.0);
 		gluCylinder(quadric, 2.0, 2.0, 10.0, detail, detail);
 		glTranslatef(0.0, 0.0, 10.0);
 		gluSphere(quadric, 2.2, detail, detail);
@@ -882,6 +845,98 @@ public:
 };
 // -------------------- Class: SkeletonRunner --------------------
 
+// -------------------- Pools of runners --------------------
+static Pool <HumanRunner, 6> humanRunners;								// Up to 4 of each kind live at once (menu, player, ghost & crowd template) - the rest is spare
+static Pool <BananaRunner, 6> bananaRunners;
+static Pool <SkeletonRunner, 6> skeletonRunners;
+
+Runner* Runner::Create(int kind) {
+	if (kind == BANANA_RUNNER)
+		return bananaRunners.acquire();
+	else if (kind == SKELETON_RUNNER)
+		return skeletonRunners.acquire();
+	return humanRunners.acquire();
+}
+
+void Runner::Destroy(Runner* runner) {
+	if (runner == NULL)
+		return;
+	if (runner->getKindOf() == BANANA_RUNNER)
+		bananaRunners.release(static_cast<BananaRunner*>(runner));
+	else if (runner->getKindOf() == SKELETON_RUNNER)
+		skeletonRunners.release(static_cast<SkeletonRunner*>(runner));
+	else
+		humanRunners.release(static_cast<HumanRunner*>(runner));
+}
+// -------------------- Pools of runners --------------------
+
+// -------------------- Class: CrowdLists --------------------
+class CrowdLists {														// Running cycle of each kind of runner compiled into display lists - every runner of a crowd is a call of one of them
+public:
+	static void Load() {
+		if (references++ > 0)
+			return;
+		base = glGenLists(Crowd::KINDS * LODS * FRAMES);
+		for (int kind = 0; kind < Crowd::KINDS; kind++) {
+			runners[kind] = Runner::Create(kind);						// Kept until unloaded - the lists use its textures
+			for (int lod = 0; lod < LODS; lod++) {
+				runners[kind]->setDetail(details[lod]);
+				for (int frame = 0; frame < Frames(lod); frame++) {
+					float rotationH, rotationL;
+					Motion::Sample(SPEED, (float)frame / Frames(lod), rotationH, rotationL);
+					runners[kind]->setMotion(Motion(SPEED, 0.0f, rotationH, rotationL));
+					glNewList(List(kind, lod, frame), GL_COMPILE);
+					runners[kind]->display();
+					glEndList();
+				}
+			}
+		}
+	}
+
+	static void Unload() {
+		if (references == 0 || --references > 0)
+			return;
+		glDeleteLists(base, Crowd::KINDS * LODS * FRAMES);
+		for (int kind = 0; kind < Crowd::KINDS; kind++)
+			Runner::Destroy(runners[kind]);
+	}
+
+	static void Display(const Crowd& crowd) {
+		PROFILE_ZONE("CrowdLists::display");
+		const unsigned char* kinds = crowd.getKinds();
+		const GLfloat *posX = crowd.getPositionsX(), *posZ = crowd.getPositionsZ(), *heights = crowd.getHeights(), *phases = crowd.getPhases();
+		for (int kind = 0; kind < Crowd::KINDS; kind++)					// A kind at a time - its textures & materials are used in turn
+			for (int i = 0; i < crowd.size(); i++) {
+				if (kinds[i] != kind)
+					continue;
+				GLfloat distance = fabs(posX[i]);
+				int lod = distance < 600.0f ? 0 : distance < 1500.0f ? 1 : 2;	// Far runners: fewer segments & poses
+				glPushMatrix();
+				glTranslatef(posX[i], heights[i], posZ[i] + 50.0f);		// Runners are displayed 50 units in front of the path's center
+				glCallList(List(kind, lod, (int)(phases[i] * Frames(lod)) % Frames(lod)));
+				glPopMatrix();
+			}
+	}
+
+private:
+	static int Frames(int lod) { return FRAMES >> lod; }				// Poses of the running cycle
+	static GLuint List(int kind, int lod, int frame) { return base + (kind * LODS + lod) * FRAMES + frame; }
+
+	static const int LODS = 3, FRAMES = 16;
+	static const GLint details[LODS];
+	static const float SPEED;											// Speed of the compiled cycle
+	static GLuint base;
+	static Runner* runners[Crowd::KINDS];
+	static int references;
+};
+
+const GLint CrowdLists::details[LODS] = { 12, 6, 3 };
+const float CrowdLists::SPEED = 15.0f;
+GLuint CrowdLists::base = 0;
+Runner* CrowdLists::runners[Crowd::KINDS];
+int CrowdLists::references = 0;
+// -------------------- Class: CrowdLists --------------------
+
 // -------------------- !! END: ALL IMPLEMENTATIONS OF CLASS RUNNER !! --------------------
 
 // -------------------- !! END: ALL IMPLEMENTATIONS OF CLASS CHARACTER !! --------------------
@@ -903,6 +958,7 @@ public:
 	}
 
 	virtual void Path::display() const {								// Display Road/Path
+		PROFILE_ZONE("Path::display");
 		Texture::Use("path");
 		specref[0] = 0.19225; specref[1] = 0.19225; specref[2] = 0.19225; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
@@ -927,9 +983,11 @@ public:
 	}
 
 	virtual void animate(GLfloat speed) {								// Animate Road/Path
+		PROFILE_ZONE("Path::animate");
 		if (roadParts.front() <= -zFar / 2.0 - 750.0) {
-			roadParts.push_back(roadParts.back() + 500.0);
-			roadParts.pop_front();
+			GLfloat back = roadParts.back();
+			roadParts.splice(roadParts.end(), roadParts, roadParts.begin());	// Move the part that is out of view in front - reuses its node
+			roadParts.back() = back + 500.0;
 		}
 		for (std::list <GLfloat>::iterator it = roadParts.begin(); it != roadParts.end(); it++)
 			(*it) -= speed / 5.0;
@@ -941,56 +999,158 @@ private:
 // -------------------- Class: Path --------------------
 
 // -------------------- Class: Tree --------------------
-class Tree : public Object {
+class Tree {															// Render handle of trees - displays a tree at the given position (far trees are impostors: a quad facing the camera)
 public:
-	Tree(GLfloat posX, GLfloat posY, GLfloat posZ) : Object(posX, posY, posZ) {
-	}
-
-	void display() const {
-		glPushMatrix();
-		glTranslatef(getPositionX(), getPositionY(), getPositionZ());
-		glScalef(600.0, 300.0, 600.0);
-		specref[0] = 0.19225; specref[1] = 0.19225; specref[2] = 0.19225; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
-		specref[0] = 0.50754; specref[1] = 0.50754; specref[2] = 0.50754; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_DIFFUSE, specref);
-		specref[0] = 0.508273; specref[1] = 0.508273; specref[2] = 0.508273; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_SPECULAR, specref);
-		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 0.0;
-		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
-		glMaterialf(GL_FRONT, GL_SHININESS, 51.2);
-		Texture::Use("green");
-		Wavefront::Display("tree");
-		glPopMatrix();
-	}
-
-	void animate(GLfloat speed) {
-		setPositionX(getPositionX() - speed / 5.0);
+	static void Display(GLfloat posX, GLfloat posY, GLfloat posZ) {
+		PROFILE_ZONE("Tree::display");
+		GLfloat distance = Detail::Distance(posX, posY, posZ);			// Trees are displayed straight in the World
+		GLfloat fade = atlas == 0 ? 0.0f : (distance - NEAR) / FADE;	// 0: model only, 1: impostor only
+		if (fade < 1.0f) {
+			glPushMatrix();
+			glTranslatef(posX, posY, posZ);
+			glScalef(600.0, 300.0, 600.0);
+			specref[0] = 0.19225; specref[1] = 0.19225; specref[2] = 0.19225; specref[3] = 1.0;
+			glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
+			specref[0] = 0.50754; specref[1] = 0.50754; specref[2] = 0.50754; specref[3] = 1.0;
+			glMaterialfv(GL_FRONT, GL_DIFFUSE, specref);
+			specref[0] = 0.508273; specref[1] = 0.508273; specref[2] = 0.508273; specref[3] = 1.0;
+			glMaterialfv(GL_FRONT, GL_SPECULAR, specref);
+			specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 0.0;
+			glMaterialfv(GL_FRONT, GL_EMISSION, specref);
+			glMaterialf(GL_FRONT, GL_SHININESS, 51.2);
+			Texture::Use("green");
+			Wavefront::Display("tree");
+			glPopMatrix();
+		}
+		if (fade > 0.0f) {												// Cross-fade: the impostor becomes opaque over the model
+			GLfloat dirX = Detail::GetEye()[0] - posX, dirZ = Detail::GetEye()[2] - posZ, length = sqrt(dirX * dirX + dirZ * dirZ);
+			if (length > 0.0f) {
+				dirX /= length;
+				dirZ /= length;
+			}
+			int view = (int)floor(atan2(-dirX, dirZ) / (2.0 * 3.14159265) * VIEWS + 0.5);	// Captured view closest to the direction of the camera
+			view = (view % VIEWS + VIEWS) % VIEWS;
+			GLfloat left = (GLfloat)(view * CELL + GUTTER) / (VIEWS * CELL), right = (GLfloat)((view + 1) * CELL - GUTTER) / (VIEWS * CELL);	// The view inside the gutter of its cell
+			GLfloat low = (GLfloat)GUTTER / CELL, high = (GLfloat)(CELL - GUTTER) / CELL;
+			GLfloat rightX = dirZ * radius, rightZ = -dirX * radius;	// Quad faces the camera - turns around the y axis only
+			glDisable(GL_LIGHTING);										// Lighting was captured with the views
+			glEnable(GL_ALPHA_TEST);
+			glAlphaFunc(GL_GREATER, 0.0f);
+			glBindTexture(GL_TEXTURE_2D, atlas);
+			glColor4f(1.0, 1.0, 1.0, fade < 1.0f ? fade : 1.0f);
+			glBegin(GL_QUADS);
+			glTexCoord2f(left, low); glVertex3f(posX - rightX, posY + bottom, posZ - rightZ);
+			glTexCoord2f(right, low); glVertex3f(posX + rightX, posY + bottom, posZ + rightZ);
+			glTexCoord2f(right, high); glVertex3f(posX + rightX, posY + top, posZ + rightZ);
+			glTexCoord2f(left, high); glVertex3f(posX - rightX, posY + top, posZ - rightZ);
+			glEnd();
+			glDisable(GL_ALPHA_TEST);
+			glEnable(GL_LIGHTING);
+		}
 	}
 
 	static void Load() {
 		Texture::Load("green");
 		Wavefront::Load("tree");
+		if (atlas == 0)
+			Capture();
 	}
 
-	static void Unload() {
+	static void Unload() {												// The atlas is kept for the life of the application - captured by the first World only
 		Texture::Unload("green");
 		Wavefront::Unload("tree");
 	}
-};
-// -------------------- Class: Tree --------------------
 
-// -------------------- Class: Container --------------------
-class Container : public Object {
-public:
-	Container(GLfloat posX, GLfloat posY, GLfloat posZ) : Object(posX, posY, posZ) {
-		Texture::Load("wood");
+private:
+	static void Capture() {												// Display the tree from VIEWS angles around it & copy each view into a cell of the atlas
+		PROFILE_ZONE("Tree::Capture");
+		float min[3], max[3];
+		if (!Wavefront::GetBounds("tree", min, max))					// No impostors - trees are always models
+			return;
+		radius = 0.0f;
+		for (int i = 0; i < 4; i++) {									// Furthest corner around the y axis - the tree fits in every view
+			GLfloat x = 600.0f * (i & 1 ? max[0] : min[0]), z = 600.0f * (i & 2 ? max[2] : min[2]);
+			if (sqrt(x * x + z * z) > radius)
+				radius = sqrt(x * x + z * z);
+		}
+		bottom = 300.0f * min[1];
+		top = 300.0f * max[1];
+		std::vector <GLubyte> image(4 * VIEWS * CELL * CELL), cell(4 * CELL * CELL);
+		glPushAttrib(GL_VIEWPORT_BIT | GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT);
+		glMatrixMode(GL_PROJECTION);
+		glPushMatrix();
+		glLoadIdentity();
+		glOrtho(-radius, radius, bottom, top, -radius - 1.0, radius + 1.0);
+		glMatrixMode(GL_MODELVIEW);
+		glPushMatrix();
+		glViewport(GUTTER, GUTTER, CELL - 2 * GUTTER, CELL - 2 * GUTTER);	// The cleared border keeps the views apart when the atlas is filtered
+		glClearColor(1.0, 0.0, 1.0, 1.0);								// Key color - becomes transparent
+		glEnable(GL_DEPTH_TEST);
+		glEnable(GL_LIGHTING);
+		glDisable(GL_BLEND);
+		Texture::Enable();
+		for (int view = 0; view < VIEWS; view++) {
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			glLoadIdentity();
+			glRotatef(360.0f * view / VIEWS, 0.0, 1.0, 0.0);			// The camera looks down -z - view i sees the tree from the angle Display picks it for
+			Display(0.0, 0.0, 0.0);										// atlas is 0 - the model is displayed
+			glReadPixels(0, 0, CELL, CELL, GL_RGBA, GL_UNSIGNED_BYTE, &cell[0]);
+			for (int y = 0; y < CELL; y++)
+				for (int x = 0; x < CELL; x++) {
+					const GLubyte* from = &cell[4 * (y * CELL + x)];
+					GLubyte* to = &image[4 * (y * CELL * VIEWS + view * CELL + x)];
+					if (!Keyed(from)) {
+						to[0] = from[0]; to[1] = from[1]; to[2] = from[2];
+						to[3] = 255;
+						continue;
+					}
+					int color[3] = { 0, 0, 0 }, opaque = 0;				// Keyed texels take the color of the tree around them - filtering blends no key color into the edges
+					for (int j = y - 1; j <= y + 1; j++)
+						for (int i = x - 1; i <= x + 1; i++)
+							if (j >= 0 && j < CELL && i >= 0 && i < CELL && !Keyed(&cell[4 * (j * CELL + i)])) {
+								for (int c = 0; c < 3; c++)
+									color[c] += cell[4 * (j * CELL + i) + c];
+								opaque++;
+							}
+					for (int c = 0; c < 3; c++)
+						to[c] = (GLubyte)(opaque > 0 ? color[c] / opaque : 0);
+					to[3] = 0;
+				}
+		}
+		glPopMatrix();
+		glMatrixMode(GL_PROJECTION);
+		glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+		glPopAttrib();
+		glGenTextures(1, &atlas);
+		glBindTexture(GL_TEXTURE_2D, atlas);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, CELL * VIEWS, CELL, 0, GL_RGBA, GL_UNSIGNED_BYTE, &image[0]);
 	}
 
-	~Container() {
+	static bool Keyed(const GLubyte* texel) {							// Texel of the key color (background of a view)
+		return texel[0] == 255 && texel[1] == 0 && texel[2] == 255;
 	}
 
-	void display() const {
+	static const int VIEWS = 8, CELL = 128, GUTTER = 1;					// Atlas of 1024 x 128 pixels - each view is GUTTER pixels inside its cell
+	static const GLfloat NEAR, FADE;									// Trees further than NEAR fade into their impostor over FADE units
+	static GLuint atlas;												// 0: no impostors
+	static GLfloat radius, bottom, top;									// Extent of the scaled model (around its position)
+};
+
+const GLfloat Tree::NEAR = 1500.0f, Tree::FADE = 500.0f;
+GLuint Tree::atlas = 0;
+GLfloat Tree::radius = 0.0f, Tree::bottom = 0.0f, Tree::top = 0.0f;
+// -------------------- Class: Tree --------------------
+
+// -------------------- Class: Container --------------------
+class Container {														// Render handle of containers - displays a container at the given position
+public:
+	static void Display(GLfloat posX, GLfloat posY, GLfloat posZ) {
+		PROFILE_ZONE("Container::display");
 		specref[0] = 0.19225; specref[1] = 0.19225; specref[2] = 0.19225; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
 		specref[0] = 0.50754; specref[1] = 0.50754; specref[2] = 0.50754; specref[3] = 1.0;
@@ -1002,28 +1162,26 @@ public:
 		glMaterialf(GL_FRONT, GL_SHININESS, 51.2);
 		Texture::Use("wood");
 		glPushMatrix();
-		glTranslatef(getPositionX(), getPositionY(), getPositionZ());
+		glTranslatef(posX, posY, posZ);
 		Cube(50.0);
 		glPopMatrix();
 	}
 
-	void animate(GLfloat speed) {
-		setPositionX(getPositionX() - speed / 5.0);
+	static void Load() {
+		Texture::Load("wood");
+	}
+
+	static void Unload() {
+		Texture::Unload("wood");
 	}
 };
 // -------------------- Class: Container --------------------
 
 // -------------------- Class: Obstacle --------------------
-class Obstacle : public Object {
+class Obstacle {														// Render handle of obstacles - displays an obstacle at the given position
 public:
-	Obstacle(GLfloat posX, GLfloat posY, GLfloat posZ) : Object(posX, posY, posZ) {
-		Texture::Load("metal");
-	}
-
-	~Obstacle() {
-	}
-
-	void display() const {
+	static void Display(GLfloat posX, GLfloat posY, GLfloat posZ) {
+		PROFILE_ZONE("Obstacle::display");
 		specref[0] = 0.19225; specref[1] = 0.19225; specref[2] = 0.19225; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
 		specref[0] = 0.50754; specref[1] = 0.50754; specref[2] = 0.50754; specref[3] = 1.0;
@@ -1035,32 +1193,43 @@ public:
 		glMaterialf(GL_FRONT, GL_SHININESS, 51.2);
 		Texture::Use("metal");
 		glPushMatrix();
-		glTranslatef(getPositionX(), getPositionY(), getPositionZ() + 50.0);
+		glTranslatef(posX, posY, posZ + 50.0);
 		glScalef(1.5, 5.0, 1.5);
 		Cube(10.0);
 		glPopMatrix();
 		glPushMatrix();
-		glTranslatef(getPositionX(), getPositionY(), getPositionZ() - 50.0);
+		glTranslatef(posX, posY, posZ - 50.0);
 		glScalef(1.5, 5.0, 1.5);
 		Cube(10.0);
 		glPopMatrix();
 		glPushMatrix();
-		glTranslatef(getPositionX(), getPositionY(), getPositionZ());
+		glTranslatef(posX, posY, posZ);
 		glScalef(1.0, 1.0, 10.0);
 		Cube(10.0);
 		glPopMatrix();
 	}
 
-	void animate(GLfloat speed) {
-		setPositionX(getPositionX() - speed / 5.0);
+	static void Load() {
+		Texture::Load("metal");
+	}
+
+	static void Unload() {
+		Texture::Unload("metal");
 	}
 };
 // -------------------- Class: Obstacle --------------------
 
+// -------------------- Render handles of the World's entities --------------------
+enum Renders { TREE, CONTAINER, OBSTACLE };								// Same order as Chunk::Kinds - obstacles are kept apart in an ObstacleRing
+static void(*const renders[])(GLfloat posX, GLfloat posY, GLfloat posZ) = { Tree::Display, Container::Display, Obstacle::Display };
+// -------------------- Render handles of the World's entities --------------------
+
 // -------------------- !! END: ALL IMPLEMENTATIONS OF CLASS OBJECT !! --------------------
 
 // -------------------- Class: Text --------------------
 void* Text::font = GLUT_STROKE_MONO_ROMAN;
+std::unordered_map <void*, Text::Glyphs> Text::fonts;
+std::unordered_map <std::string, std::vector <GLfloat> > Text::runs;
 
 Text::Text(const char* _str, int _style, GLfloat _startposx, GLfloat _startposy)
 	: str(_str), style(_style), startposx(_startposx), startposy(_startposy), fade(false), r(0.0), g(1.0), b(0.0) {
@@ -1091,6 +1260,7 @@ Text::Text(const char* _str, int _style, GLfloat _startposx, GLfloat _startposy)
 		alpha = 0.0;
 		break;
 	}
+	vertices = &GetRun(str);
 }
 
 void Text::display() const {
@@ -1102,28 +1272,33 @@ void Text::display() const {
 	case BLINKING_APPEAR:
 		glPushMatrix();
 		glTranslatef(startposx, startposy, 0.0);
-		for (int i = 0; str[i] != '\0'; i++)
-			glutStrokeCharacter(Text::font, str[i]);
+		Draw(*vertices);
 		glPopMatrix();
 		break;
-	case APPEAR_ROTATE_Y:
+	case APPEAR_ROTATE_Y: {												// Each character rotates on its own - drawn separately from the font's geometry
+		const Glyphs& glyphs = GetGlyphs();
 		glPushMatrix();
 		glTranslatef(startposx, startposy, 0.0);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, &glyphs.vertices[0]);
 		for (int i = 0; str[i] != '\0'; i++) {
+			int c = str[i] & 127;
 			glPushMatrix();
 			glTranslatef(i*100.0, 0.0, 0.0);
 			glRotatef(rotationY, 0.0, 1.0, 0.0);
-			glutStrokeCharacter(Text::font, str[i]);
+			if (glyphs.count[c] > 0)
+				glDrawArrays(GL_LINES, glyphs.first[c], glyphs.count[c]);
 			glPopMatrix();
 		}
+		glDisableClientState(GL_VERTEX_ARRAY);
 		glPopMatrix();
 		break;
+	}
 	case MOVE_RIGHT:
 	case MOVE_LEFT:
 		glPushMatrix();
 		glTranslatef(curposx, startposy, 0.0);
-		for (int i = 0; str[i] != '\0'; i++)
-			glutStrokeCharacter(Text::font, str[i]);
+		Draw(*vertices);
 		glPopMatrix();
 		break;
 	}
@@ -1193,8 +1368,187 @@ void Text::setFade(bool fade) {
 const char* Text::getText() const {
 	return str;
 }
+
+void Text::displayCached(const char* str) {
+	static std::vector <GLfloat> vertices;								// Reused - the strings change every frame
+	vertices.clear();
+	Build(str, vertices);
+	Draw(vertices);
+}
+
+void Text::Unload() {
+	fonts.clear();
+	runs.clear();
+}
+
+const Text::Glyphs& Text::GetGlyphs() {
+	std::unordered_map <void*, Glyphs>::iterator it = fonts.find(font);
+	if (it != fonts.end())												// If font has already been captured
+		return it->second;
+	Glyphs& glyphs = fonts[font];
+	std::vector <GLfloat> feedback(16384);
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glViewport(0, 0, 1024, 1024);										// Window coordinates = object coordinates + 512
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(-512.0, 512.0, -512.0, 512.0, -1.0, 1.0);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	for (int c = 0; c < 128; c++) {
+		glLoadIdentity();
+		glFeedbackBuffer((GLsizei)feedback.size(), GL_2D, &feedback[0]);
+		glRenderMode(GL_FEEDBACK);										// Nothing is drawn - the transformed vertices are returned instead
+		(glutStrokeCharacter)(font, c);									// Not counted as a draw call
+		GLint size = glRenderMode(GL_RENDER);
+		glyphs.first[c] = (GLint)glyphs.vertices.size() / 2;
+		for (GLint i = 0; i < size; ) {
+			GLint token = (GLint)feedback[i++];
+			if (token == GL_LINE_TOKEN || token == GL_LINE_RESET_TOKEN) {	// Each segment of the strokes
+				for (int v = 0; v < 4; v++)
+					glyphs.vertices.push_back(feedback[i++] - 512.0f);
+			}
+			else if (token == GL_POINT_TOKEN)
+				i += 2;
+			else if (token == GL_POLYGON_TOKEN)
+				i += 1 + 2 * (GLint)feedback[i];
+			else														// GL_PASS_THROUGH_TOKEN
+				i++;
+		}
+		glyphs.count[c] = (GLint)glyphs.vertices.size() / 2 - glyphs.first[c];
+		glyphs.advance[c] = (GLfloat)glutStrokeWidth(font, c);
+	}
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	return glyphs;
+}
+
+void Text::Build(const char* str, std::vector <GLfloat>& vertices) {
+	const Glyphs& glyphs = GetGlyphs();
+	GLfloat x = 0.0;
+	for (int i = 0; str[i] != '\0'; i++) {
+		int c = str[i] & 127;
+		for (GLint v = glyphs.first[c]; v < glyphs.first[c] + glyphs.count[c]; v++) {
+			vertices.push_back(glyphs.vertices[2 * v] + x);
+			vertices.push_back(glyphs.vertices[2 * v + 1]);
+		}
+		x += glyphs.advance[c];
+	}
+}
+
+const std::vector <GLfloat>& Text::GetRun(const char* str) {
+	std::unordered_map <std::string, std::vector <GLfloat> >::iterator it = runs.find(str);
+	if (it != runs.end())												// If string has already been built
+		return it->second;
+	std::vector <GLfloat>& run = runs[str];
+	Build(str, run);
+	return run;
+}
+
+void Text::Draw(const std::vector <GLfloat>& vertices) {
+	if (vertices.empty())
+		return;
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, &vertices[0]);
+	glDrawArrays(GL_LINES, 0, (GLsizei)vertices.size() / 2);
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
 // -------------------- Class: Text --------------------
 
+// -------------------- Class: Hud --------------------
+Hud::Hud() : lastFrame(Timer::GetTime()), lastSample(lastFrame), utilization(0.0), current(0), visible(false) {
+	for (int i = 0; i < SAMPLES; i++) {
+		frameTimes[i] = 0.0;
+		graph[2 * i] = 2.0 * i;
+		graph[2 * i + 1] = 0.0;
+	}
+}
+
+void Hud::display(double simulationTime, double renderTime) const {
+	if (!visible)
+		return;
+	int width = glutGet(GLUT_WINDOW_WIDTH), height = glutGet(GLUT_WINDOW_HEIGHT);
+	double average = 0.0;
+	for (int i = 0; i < SAMPLES; i++)
+		average += frameTimes[i];
+	average /= SAMPLES;
+	char lines[8][64];													// Formatted on the stack - nothing is allocated per frame
+	snprintf(lines[0], 64, "FPS        : %.1f", average > 0.0 ? 1000.0 / average : 0.0);
+	snprintf(lines[1], 64, "Frame      : %.2f ms", frameTimes[(current + SAMPLES - 1) % SAMPLES]);
+	snprintf(lines[2], 64, "Simulation : %.2f ms", simulationTime);
+	snprintf(lines[3], 64, "Render     : %.2f ms", renderTime);
+	snprintf(lines[4], 64, "Draw Calls : %lu", Statistics::GetLastFrame(Statistics::DRAW_CALLS));
+	snprintf(lines[5], 64, "Textures   : %.1f MB", Texture::GetMemoryUsage() / 1048576.0);
+	snprintf(lines[6], 64, "Audio      : %.1f MB", Audio::GetMemoryUsage() / 1048576.0);
+	snprintf(lines[7], 64, "Jobs       : %d x %.0f%%", ThreadPool::Shared().getThreads(), utilization * 100.0);
+	glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);						// Restored when the overlay is drawn
+	glDisable(GL_LIGHTING);
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_DEPTH_TEST);
+	glMatrixMode(GL_PROJECTION);										// Screen space - one unit per pixel
+	glPushMatrix();
+	glLoadIdentity();
+	gluOrtho2D(0.0, width, 0.0, height);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+	glTranslatef(10.0, height - 250.0, 0.0);
+	glColor4f(0.0, 0.0, 0.0, 0.6);										// Background - behind every line & the graph
+	glRectf(0.0, 0.0, 260.0, 240.0);
+	glColor4f(0.0, 1.0, 0.0, 1.0);
+	for (int i = 0; i < 8; i++) {
+		glPushMatrix();
+		glTranslatef(10.0, 220.0 - 20.0 * i, 0.0);
+		glScalef(0.12, 0.12, 1.0);
+		Text::displayCached(lines[i]);
+		glPopMatrix();
+	}
+	glTranslatef(10.0, 10.0, 0.0);										// Frame time graph - 60 pixels for 50 ms
+	glColor4f(1.0, 1.0, 0.0, 0.5);
+	glRectf(0.0, 20.0, 2.0 * SAMPLES, 20.5);							// Line at 60 FPS
+	glColor4f(1.0, 1.0, 0.0, 1.0);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, graph);
+	glDrawArrays(GL_LINE_STRIP, 0, SAMPLES);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+}
+
+void Hud::update() {
+	double now = Timer::GetTime();
+	frameTimes[current] = now - lastFrame;
+	lastFrame = now;
+	current = (current + 1) % SAMPLES;
+	if (now - lastSample >= 1000.0) {									// Workers of the pool are sampled every second
+		ThreadPool& pool = ThreadPool::Shared();
+		utilization = pool.getUtilization();
+		pool.resetStats();
+		lastSample = now;
+		Profiler::Counter("Job utilization (%)", (long long)(utilization * 100.0));
+	}
+	for (int i = 0; i < SAMPLES; i++) {									// Oldest frame first
+		double frameTime = frameTimes[(current + i) % SAMPLES];
+		graph[2 * i + 1] = (frameTime < 50.0 ? frameTime : 50.0) * 60.0 / 50.0;
+	}
+}
+
+void Hud::toggle() {
+	visible = !visible;
+}
+
+bool Hud::isVisible() const {
+	return visible;
+}
+// -------------------- Class: Hud --------------------
+
 // -------------------- Namespace: Graphics --------------------
 namespace Graphics {
 	// -------------------- Basic functions used by glut when each specific event occurs --------------------
@@ -1224,16 +1578,25 @@ namespace Graphics {
 		quadric = gluNewQuadric();
 		gluQuadricTexture(quadric, true);								// Enable generation of texture coordinates for quadric object
 		gluQuadricNormals(quadric, GLU_SMOOTH);
-		graphics = new Intro();
+		for (int i = 0; i < 128; i++)									// 32 rows of 4 bytes - alternate rows are shifted by a pixel
+			halftone[i] = (i / 4) % 2 ? 0x55 : 0xAA;
+		glPolygonStipple(halftone);										// Used only where GL_POLYGON_STIPPLE is enabled
+		SceneManager::Init();
+	}
+
+	void SetCrowd(int runners) {
+		crowdRunners = runners;
 	}
 
 	void Exit() {														// Clean up Graphics Library
 		gluDeleteQuadric(quadric);
-		delete graphics;
+		SceneManager::Exit();
+		Text::Unload();
 	}
 
 	void reshape(int width, int height) {								// Main reshape function - when window is resized
 		glViewport(0, 0, (GLsizei)width, (GLsizei)height);				// Establish Viewport (the whole window)
+		Detail::SetViewport(height);
 		glMatrixMode(GL_PROJECTION);									// Select the projection matrix
 		glLoadIdentity();												// Initialize projection matrix to identical
 		gluPerspective(60.0, (GLdouble)width / (GLdouble)height, 1.0, zFar);	// Establish desired projection
@@ -1242,7 +1605,12 @@ namespace Graphics {
 
 	void display() {													// Main display function
 		Timer::Start();													// Start Timer
-		graphics->display();											// Display content
+		PROFILE_ZONE("Graphics::display");
+		Statistics::BeginFrame(SceneManager::Current()->getName());	// Count the OpenGL calls of this frame
+		double start = Timer::GetTime();
+		SceneManager::Current()->display();								// Display content
+		renderTime = Timer::GetTime() - start;
+		Statistics::EndFrame();
 		Utilities::Update();											// Update Utilities Library
 		glutSwapBuffers();												// Swap buffers
 		Timer::Stop();													// Stop Timer
@@ -1250,47 +1618,143 @@ namespace Graphics {
 	}
 
 	void animate() {													// Main animation function
-		graphics->animate();
+		PROFILE_ZONE("Graphics::animate");
+		SceneManager::Current()->animate();
 	}
 
 	void keyboard(unsigned char key, int x, int y) {					// Main keyboard callback function
-		graphics->keyboard(key, x, y);
+		SceneManager::Current()->keyboard(key, x, y);
 	}
 
 	void specialKeyboard(int key, int x, int y) {						// Main special keyboard callback function
-		graphics->specialKeyboard(key, x, y);
+		if (key == GLUT_KEY_F12) {										// F12 -> Dump profiled zones & frame statistics (available in every scene)
+			Profiler::Dump();
+			Statistics::Dump();
+		}
+		SceneManager::Current()->specialKeyboard(key, x, y);
 	}
 	// -------------------- Basic functions used by glut when each specific event occurs --------------------
 
+	// -------------------- Class: SceneManager --------------------
+	Graphics* SceneManager::scenes[SCENES];
+	std::vector <Graphics*> SceneManager::stack;
+	World* SceneManager::walk = NULL;
+
+	void SceneManager::Init() {
+		stack.push_back(Get(INTRO));
+		stack.back()->onEnter();
+	}
+
+	void SceneManager::Exit() {
+		if (!stack.empty())
+			stack.back()->onExit();
+		if (walk != NULL)
+			delete walk;
+		walk = NULL;
+		for (int i = 0; i < SCENES; i++) {
+			delete scenes[i];
+			scenes[i] = NULL;
+		}
+		stack.clear();
+		World::Unload();
+	}
+
+	Graphics* SceneManager::Current() {
+		return stack.back();
+	}
+
+	void SceneManager::Switch(int scene) {
+		Graphics* next = Get(scene);
+		Leave();
+		stack.push_back(next);
+		next->onEnter();
+	}
+
+	void SceneManager::Push(int scene) {
+		Graphics* next = Get(scene);
+		stack.back()->onExit();
+		stack.push_back(next);
+		next->onEnter();
+	}
+
+	void SceneManager::Pop() {
+		Leave();
+		stack.back()->onEnter();
+	}
+
+	void SceneManager::Start(int character) {
+		Leave();
+		stack.clear();													// Only the paused walk can be below the menus
+		if (walk != NULL)
+			delete walk;
+		walk = new World(character);
+		stack.push_back(walk);
+		walk->onEnter();
+	}
+
+	bool SceneManager::HasPausedWalk() {
+		return walk != NULL;
+	}
+
+	Graphics* SceneManager::Get(int scene) {
+		if (scenes[scene] == NULL)
+			switch (scene) {
+			case INTRO: scenes[scene] = new Intro(); break;
+			case MAIN_MENU: scenes[scene] = new MainMenu(); break;
+			case NEW_GAME_MENU: scenes[scene] = new NewGameMenu(); break;
+			case OPTIONS_MENU: scenes[scene] = new OptionsMenu(); break;
+			case SOUND_MENU: scenes[scene] = new SoundMenu(); break;
+			case KEYBOARD_MENU: scenes[scene] = new KeyboardMenu(); break;
+			case QUIT: scenes[scene] = new Quit(); break;
+			}
+		return scenes[scene];
+	}
+
+	void SceneManager::Leave() {
+		Graphics* scene = stack.back();
+		stack.pop_back();
+		scene->onExit();
+		if (scene == scenes[INTRO]) {									// The intro plays from the start each time - it isn't kept
+			delete scene;
+			scenes[INTRO] = NULL;
+		}
+	}
+	// -------------------- Class: SceneManager --------------------
+
 	// -------------------- Class: Intro --------------------
-	Intro::Intro() : elapsedTime(0.0) {
+	Intro::Intro() : strs(&arena), elapsedTime(0.0) {
+	}
+
+	Intro::~Intro() {
+		strs.clear();
+	}
+
+	void Intro::onEnter() {
 		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
 		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
-		strs.clear();
 		Audio::Load("intro");
 		Audio::SetVolume("intro", 0.25);
 		Audio::Play("intro");
 	}
 
-	Intro::~Intro() {
+	void Intro::onExit() {
 		glDisable(GL_LINE_SMOOTH);
 		Audio::Stop("intro");
 		Audio::Unload("intro");
-		strs.clear();
 	}
 
 	void Intro::display() const {
 		glClearColor(0.07, 0.07, 0.07, 1.0);							// Set clearing color
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);				// Clear Color, depth & stencil buffers
 		glLoadIdentity();												// Initialize modelview matrix to identical
-		std::list <Text>::const_iterator it;
+		TextList::const_iterator it;
 		glTranslatef(0.0, 0.0, -4900.0);
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->display();
 	}
 
 	void Intro::animate() {
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->animate();
 		elapsedTime += Timer::GetElapsedTime();
@@ -1326,15 +1790,17 @@ namespace Graphics {
 			for (it = strs.begin(); it != strs.end(); it++)
 				it->setFade(true);
 		}
-		if (elapsedTime >= 18000) {
-			delete graphics;
-			graphics = new MainMenu();
-		}
+		if (elapsedTime >= 18000)
+			SceneManager::Switch(SceneManager::MAIN_MENU);
+	}
+
+	const char* Intro::getName() const {
+		return "Intro";
 	}
 
 	void Intro::keyboard(unsigned char key, int x, int y) {
 		switch (key) {
-		case 27: delete graphics; graphics = new MainMenu(); break;
+		case 27: SceneManager::Switch(SceneManager::MAIN_MENU); break;
 		}
 	}
 	// -------------------- Class: Intro --------------------
@@ -1342,17 +1808,7 @@ namespace Graphics {
 	// -------------------- Class: MainMenu --------------------
 	bool MainMenu::changed = false;
 
-	MainMenu::MainMenu() : elapsedTime(0.0) {
-		if (!Audio::IsPlaying("main_theme")) {
-			Audio::Load("main_theme");
-			Audio::SetRepeat("main_theme", true);
-			Audio::Play("main_theme");
-		}
-		else {
-			Audio::SetPaused("main_theme", false);
-		}
-		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
-		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	MainMenu::MainMenu() : strs(&arena), elapsedTime(0.0) {
 		if (changed) {
 			strs.push_back(Text("New Game", Text::NORMAL, -(int)strlen("New Game") / 2 * 100, 400.0));
 			strs.push_back(Text("Continue", Text::NORMAL, -(int)strlen("Continue") / 2 * 100, 200.0));
@@ -1367,7 +1823,7 @@ namespace Graphics {
 			strs.push_back(Text("Replay Intro", Text::MOVE_RIGHT, -(int)strlen("Replay Intro") / 2 * 100, -200.0));
 			strs.push_back(Text("Quit", Text::MOVE_LEFT, -(int)strlen("Quit") / 2 * 100, -400.0));
 		}
-		std::list <Text>::iterator it = strs.begin();;
+		TextList::iterator it = strs.begin();;
 		if (changed) {
 			selected = NEW_GAME;
 			it->setStyle(Text::BLINKING_FADE);
@@ -1375,30 +1831,48 @@ namespace Graphics {
 		}
 		else
 			selected = NONE;
-		if (lastRace == NULL) {
-			int c = CONTINUE;
-			advance(it, c);
-			it->setColor(0.5, 0.5, 0.5);
-		}
 	}
 
 	MainMenu::~MainMenu() {
-		glDisable(GL_LINE_SMOOTH);
 		strs.clear();
 	}
 
+	void MainMenu::onEnter() {
+		if (!Audio::IsPlaying("main_theme")) {
+			Audio::Load("main_theme");
+			Audio::SetRepeat("main_theme", true);
+			Audio::Play("main_theme");
+		}
+		else {
+			Audio::SetPaused("main_theme", false);
+		}
+		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
+		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+		TextList::iterator it = strs.begin();
+		int c = CONTINUE;
+		advance(it, c);
+		if (!SceneManager::HasPausedWalk())								// Nothing to continue yet
+			it->setColor(0.5, 0.5, 0.5);
+		else if (selected != CONTINUE)
+			it->setColor(0.0, 1.0, 0.0);
+	}
+
+	void MainMenu::onExit() {
+		glDisable(GL_LINE_SMOOTH);
+	}
+
 	void MainMenu::display() const {
 		glClearColor(0.07, 0.07, 0.07, 1.0);							// Set clearing color
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);				// Clear Color, depth & stencil buffers
 		glLoadIdentity();												// Initialize modelview matrix to identical
-		std::list <Text>::const_iterator it;
+		TextList::const_iterator it;
 		glTranslatef(0.0, 0.0, -4900.0);
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->display();
 	}
 
 	void MainMenu::animate() {
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		for (it = strs.begin(); it != strs.end(); it++) {
 			it->animate();
 			if (!changed) {
@@ -1419,30 +1893,30 @@ namespace Graphics {
 		}
 	}
 
+	const char* MainMenu::getName() const {
+		return "MainMenu";
+	}
+
 	void MainMenu::keyboard(unsigned char key, int x, int y) {
 		if (!changed)
 			return;
 		switch (key) {
 		case 13:
 			if (selected == NEW_GAME) {
-				delete graphics;
-				graphics = new NewGameMenu();
+				SceneManager::Switch(SceneManager::NEW_GAME_MENU);
 			}
-			else if (selected == CONTINUE && lastRace != NULL) {
-				lastRace->continueWalk();
+			else if (selected == CONTINUE && SceneManager::HasPausedWalk()) {
+				SceneManager::Pop();									// The walk is below the menus
 			}
 			else if (selected == OPTIONS) {
-				delete graphics;
-				graphics = new OptionsMenu();
+				SceneManager::Switch(SceneManager::OPTIONS_MENU);
 			}
 			else if (selected == REPLAY_INTRO) {
 				Audio::SetPaused("main_theme", true);
-				delete graphics;
-				graphics = new Intro();
+				SceneManager::Switch(SceneManager::INTRO);
 			}
 			else if (selected == QUIT) {
-				delete graphics;
-				graphics = new Quit();
+				SceneManager::Push(SceneManager::QUIT);
 			}
 			break;
 		}
@@ -1454,12 +1928,12 @@ namespace Graphics {
 		switch (key) {
 		case GLUT_KEY_UP:
 			if (selected > NEW_GAME) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
 				--selected;
-				if (selected == CONTINUE && lastRace == NULL) {
+				if (selected == CONTINUE && !SceneManager::HasPausedWalk()) {
 					--selected;
 					--it;
 				}
@@ -1470,12 +1944,12 @@ namespace Graphics {
 			break;
 		case GLUT_KEY_DOWN:
 			if (selected < QUIT) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
 				++selected;
-				if (selected == CONTINUE && lastRace == NULL) {
+				if (selected == CONTINUE && !SceneManager::HasPausedWalk()) {
 					++selected;
 					++it;
 				}
@@ -1489,28 +1963,40 @@ namespace Graphics {
 	// -------------------- Class: MainMenu --------------------
 
 	// -------------------- Class: NewGameMenu --------------------
-	NewGameMenu::NewGameMenu() {
-		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
-		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	NewGameMenu::NewGameMenu() : strs(&arena), characters(&arena) {
 		strs.push_back(Text("Main Menu", Text::NORMAL, -(int)strlen("Main Menu") / 2 * 100 - 3500, 2500.0));
 		strs.push_back(Text("Select Character", Text::NORMAL, -(int)strlen("Select Character") / 2 * 100, 2500.0));
 		Text text("Start Game", Text::BLINKING_FADE, -(int)strlen("Start Game") / 2 * 100 + 3500, 2500.0);
 		text.setColor(1.0, 1.0, 0.0);
 		strs.push_back(text);
 		selected = START_GAME;
-		characters.push_back(new HumanRunner());
-		characters.push_back(new BananaRunner());
-		characters.push_back(new SkeletonRunner());
-		Audio::SetVolume("step", 0.0);
+		characters.push_back(Runner::Create(Character::HUMAN_RUNNER));
+		characters.push_back(Runner::Create(Character::BANANA_RUNNER));
+		characters.push_back(Runner::Create(Character::SKELETON_RUNNER));
+		loading = arena.create<Text>("Loading", Text::BLINKING_FADE, -(int)strlen("Loading") / 2 * 100, -2500.0);
+		loading->setColor(1.0, 1.0, 0.0);
+		starting = false;
 	}
 
 	NewGameMenu::~NewGameMenu() {
-		glDisable(GL_LINE_SMOOTH);
 		strs.clear();
-		std::list <Runner*>::iterator itb;
+		RunnerList::iterator itb;
 		for (itb = characters.begin(); itb != characters.end(); itb++)
-			delete *itb;
+			Runner::Destroy(*itb);
 		characters.clear();
+		Arena::Destroy(loading);
+	}
+
+	void NewGameMenu::onEnter() {
+		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
+		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+		Audio::SetVolume("step", 0.0);
+		World::Preload();												// Ready by the time a character has been chosen
+	}
+
+	void NewGameMenu::onExit() {
+		glDisable(GL_LINE_SMOOTH);
+		Audio::SetVolume("step", 0.6);
 	}
 
 	void NewGameMenu::display() const {
@@ -1519,21 +2005,23 @@ namespace Graphics {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);				// Clear Color, depth & stencil buffers
 		glLoadIdentity();												// Initialize modelview matrix to identical
 		glTranslatef(0.0, 0.0, -4900.0);
-		std::list <Text>::const_iterator ita;
+		TextList::const_iterator ita;
 		for (ita = strs.begin(); ita != strs.end(); ita++)
 			ita->display();
-		std::list <Runner*>::const_iterator itb;
+		if (starting)
+			loading->display();
+		RunnerList::const_iterator itb;
 		glEnable(GL_LIGHTING);
 		Texture::Enable();
 		glLoadIdentity();
-		if (selected == CHOOSING_CHARACTER)
-			glTranslatef(-50.0, -50.0, -150.0);
-		else
-			glTranslatef(-50.0, -50.0, -250.0);
+		Detail::SetEye(0.0, 0.0, 0.0);									// No camera - the runners are placed in front of the eye
+		GLfloat depth = selected == CHOOSING_CHARACTER ? -150.0 : -250.0;
+		glTranslatef(-50.0, -50.0, depth);
 		for (itb = characters.begin(), i = -1; itb != characters.end(); itb++, i++) {
 			glPushMatrix();
 			glTranslatef(i*100.0, 0.0, 0.0);
 			glRotatef(-90.0, 0.0, 1.0, 0.0);
+			(*itb)->setPosition(i*100.0 - 50.0, -50.0, depth);
 			(*itb)->display();
 			glPopMatrix();
 		}
@@ -1542,37 +2030,46 @@ namespace Graphics {
 	}
 
 	void NewGameMenu::animate() {
-		std::list <Text>::iterator ita;
+		TextList::iterator ita;
 		for (ita = strs.begin(); ita != strs.end(); ita++)
 			ita->animate();
-		std::list <Runner*>::iterator itb;
+		RunnerList::iterator itb;
 		for (itb = characters.begin(); itb != characters.end(); itb++)
 			(*itb)->animate();
+		if (starting) {
+			loading->animate();
+			if (!World::IsLoading()) {									// Preloading has finished - hand over to the walk
+				starting = false;
+				itb = characters.begin();
+				advance(itb, characters.size() / 2);
+				SceneManager::Start((*itb)->getKindOf());
+			}
+		}
+	}
+
+	const char* NewGameMenu::getName() const {
+		return "NewGameMenu";
 	}
 
 	void NewGameMenu::keyboard(unsigned char key, int x, int y) {
+		if (starting)													// Waiting for the walk to be loaded
+			return;
 		switch (key) {
 		case 13:
 			if (selected == MAIN_MENU) {
-				delete graphics;
-				graphics = new MainMenu();
+				SceneManager::Switch(SceneManager::MAIN_MENU);
 			}
 			else if (selected == START_GAME) {
-				Audio::SetPaused("main_theme", true);
-				std::list <Runner*>::iterator it = characters.begin();
-				advance(it, characters.size() / 2);
-				int character = (*it)->getKindOf();
-				delete graphics;
-				graphics = new World(character);
+				starting = true;										// The walk starts with the next animation step - or once it has been preloaded
 			}
 			else if (selected == SELECT_CHARACTER) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				selected = CHOOSING_CHARACTER;
 			}
 			else if (selected == CHOOSING_CHARACTER) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				selected = SELECT_CHARACTER;
 				advance(it, selected);
 				it->setStyle(Text::BLINKING_FADE);
@@ -1585,7 +2082,7 @@ namespace Graphics {
 		switch (key) {
 		case GLUT_KEY_LEFT:
 			if (selected != CHOOSING_CHARACTER && selected > MAIN_MENU) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
@@ -1595,15 +2092,12 @@ namespace Graphics {
 				it->setColor(1.0, 1.0, 0.0);
 			}
 			else if (selected == CHOOSING_CHARACTER) {
-				for (unsigned int i = 0; i < characters.size() - 1; i++) {
-					characters.push_front(characters.back());
-					characters.pop_back();
-				}
+				characters.splice(characters.end(), characters, characters.begin());	// Rotate by moving the node - nothing is allocated in the arena
 			}
 			break;
 		case GLUT_KEY_RIGHT:
 			if (selected != CHOOSING_CHARACTER && selected < START_GAME) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
@@ -1613,10 +2107,7 @@ namespace Graphics {
 				it->setColor(1.0, 1.0, 0.0);
 			}
 			else if (selected == CHOOSING_CHARACTER) {
-				for (unsigned int i = 0; i < characters.size() - 1; i++) {
-					characters.push_back(characters.front());
-					characters.pop_front();
-				}
+				characters.splice(characters.begin(), characters, --characters.end());
 			}
 			break;
 		}
@@ -1624,56 +2115,63 @@ namespace Graphics {
 	// -------------------- Class: NewGameMenu --------------------
 
 	// -------------------- Class: OptionsMenu --------------------
-	OptionsMenu::OptionsMenu() {
-		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
-		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	OptionsMenu::OptionsMenu() : strs(&arena) {
 		strs.push_back(Text("Sound", Text::NORMAL, -(int)strlen("Sound") / 2 * 100, 200.0));
 		strs.push_back(Text("Keyboard Layout", Text::NORMAL, -(int)strlen("Keyboard Layout") / 2 * 100, 0.0));
 		strs.push_back(Text("Main Menu", Text::NORMAL, -(int)strlen("Main Menu") / 2 * 100, -200.0));
 		selected = MAIN_MENU;
 		int s = MAIN_MENU;
-		std::list <Text>::iterator it = strs.begin();
+		TextList::iterator it = strs.begin();
 		advance(it, s);
 		it->setColor(1.0, 1.0, 0.0);
 		it->setStyle(Text::BLINKING_FADE);
 	}
 
 	OptionsMenu::~OptionsMenu() {
-		glDisable(GL_LINE_SMOOTH);
 		strs.clear();
 	}
 
+	void OptionsMenu::onEnter() {
+		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
+		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	}
+
+	void OptionsMenu::onExit() {
+		glDisable(GL_LINE_SMOOTH);
+	}
+
 	void OptionsMenu::display() const {
 		glClearColor(0.07, 0.07, 0.07, 1.0);							// Set clearing color
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);				// Clear Color, depth & stencil buffers
 		glLoadIdentity();												// Initialize modelview matrix to identical
-		std::list <Text>::const_iterator it;
+		TextList::const_iterator it;
 		glTranslatef(0.0, 0.0, -4900.0);
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->display();
 	}
 
 	void OptionsMenu::animate() {
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		for (it = strs.begin(); it != strs.end(); it++) {
 			it->animate();
 		}
 	}
 
+	const char* OptionsMenu::getName() const {
+		return "OptionsMenu";
+	}
+
 	void OptionsMenu::keyboard(unsigned char key, int x, int y) {
 		switch (key) {
 		case 13:
 			if (selected == MAIN_MENU) {
-				delete graphics;
-				graphics = new MainMenu();
+				SceneManager::Switch(SceneManager::MAIN_MENU);
 			}
 			else if (selected == SOUND) {
-				delete graphics;
-				graphics = new SoundMenu();
+				SceneManager::Switch(SceneManager::SOUND_MENU);
 			}
 			else if (selected == KEYBOARD) {
-				delete graphics;
-				graphics = new KeyboardMenu();
+				SceneManager::Switch(SceneManager::KEYBOARD_MENU);
 			}
 			break;
 		}
@@ -1683,7 +2181,7 @@ namespace Graphics {
 		switch (key) {
 		case GLUT_KEY_UP:
 			if (selected > SOUND) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
@@ -1695,7 +2193,7 @@ namespace Graphics {
 			break;
 		case GLUT_KEY_DOWN:
 			if (selected < MAIN_MENU) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
@@ -1710,9 +2208,7 @@ namespace Graphics {
 	// -------------------- Class: OptionsMenu --------------------
 
 	// -------------------- Class: SoundMenu --------------------
-	SoundMenu::SoundMenu() {
-		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
-		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	SoundMenu::SoundMenu() : strs(&arena) {
 		selected = OPTIONS;
 		strs.push_back(Text("+", Text::NORMAL, 4400.0 - strlen("Back to Options") / 2 * 100, 400.0));
 		strs.push_back(Text("-", Text::NORMAL, 4400.0 - strlen("Back to Options") / 2 * 100, 200.0));
@@ -1722,15 +2218,23 @@ namespace Graphics {
 	}
 
 	SoundMenu::~SoundMenu() {
-		glDisable(GL_LINE_SMOOTH);
 		strs.clear();
 	}
 
+	void SoundMenu::onEnter() {
+		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
+		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	}
+
+	void SoundMenu::onExit() {
+		glDisable(GL_LINE_SMOOTH);
+	}
+
 	void SoundMenu::display() const {
 		glClearColor(0.07, 0.07, 0.07, 1.0);							// Set clearing color
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);				// Clear Color, depth & stencil buffers
 		glLoadIdentity();												// Initialize modelview matrix to identical
-		std::list <Text>::const_iterator it;
+		TextList::const_iterator it;
 		glTranslatef(0.0, 0.0, -4900.0);
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->display();
@@ -1757,12 +2261,16 @@ namespace Graphics {
 	}
 
 	void SoundMenu::animate() {
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		for (it = strs.begin(); it != strs.end(); it++) {
 			it->animate();
 		}
 	}
 
+	const char* SoundMenu::getName() const {
+		return "SoundMenu";
+	}
+
 	void SoundMenu::keyboard(unsigned char key, int x, int y) {
 		switch (key) {
 		case 13:
@@ -1773,8 +2281,7 @@ namespace Graphics {
 				Audio::SetMasterVolume(Audio::GetMasterVolume() - 5);
 			}
 			else if (selected == OPTIONS) {
-				delete graphics;
-				graphics = new OptionsMenu();
+				SceneManager::Switch(SceneManager::OPTIONS_MENU);
 			}
 			break;
 		}
@@ -1784,7 +2291,7 @@ namespace Graphics {
 		switch (key) {
 		case GLUT_KEY_UP:
 			if (selected > INCREASE_VOLUME) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
@@ -1796,7 +2303,7 @@ namespace Graphics {
 			break;
 		case GLUT_KEY_DOWN:
 			if (selected < OPTIONS) {
-				std::list <Text>::iterator it = strs.begin();
+				TextList::iterator it = strs.begin();
 				advance(it, selected);
 				it->setStyle(Text::NORMAL);
 				it->setColor(0.0, 1.0, 0.0);
@@ -1811,12 +2318,14 @@ namespace Graphics {
 	// -------------------- Class: SoundMenu --------------------
 
 	// -------------------- Class: KeyboardMenu --------------------
-	KeyboardMenu::KeyboardMenu() {
-		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
-		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	KeyboardMenu::KeyboardMenu() : strs(&arena) {
 		strs.push_back(Text("> General <", Text::NORMAL, -4500.0, 2200.0));
 		strs.push_back(Text("Back to Main Menu:", Text::NORMAL, -4500.0, 1900.0));
 		strs.push_back(Text("Esc", Text::NORMAL, -2300.0 - 150, 1900.0));
+		strs.push_back(Text("Dump Profile:", Text::NORMAL, -4500.0, 1700.0));
+		strs.push_back(Text("F12", Text::NORMAL, -2300.0 - 150, 1700.0));
+		strs.push_back(Text("Performance HUD:", Text::NORMAL, -4500.0, 1500.0));
+		strs.push_back(Text("H", Text::NORMAL, -2300.0, 1500.0));
 		strs.push_back(Text("> Camera <", Text::NORMAL, -4500.0, 1200.0));
 		strs.push_back(Text("Rotate Left:", Text::NORMAL, -4500.0, 900.0));
 		strs.push_back(Text("4", Text::NORMAL, -2300.0, 900.0));
@@ -1843,40 +2352,52 @@ namespace Graphics {
 	}
 
 	KeyboardMenu::~KeyboardMenu() {
-		glDisable(GL_LINE_SMOOTH);
 		strs.clear();
 	}
 
+	void KeyboardMenu::onEnter() {
+		glEnable(GL_LINE_SMOOTH);										// Enable Line Smoothing
+		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+	}
+
+	void KeyboardMenu::onExit() {
+		glDisable(GL_LINE_SMOOTH);
+	}
+
 	void KeyboardMenu::display() const {
 		glClearColor(0.07, 0.07, 0.07, 1.0);							// Set clearing color
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);				// Clear Color, depth & stencil buffers
 		glLoadIdentity();												// Initialize modelview matrix to identical
-		std::list <Text>::const_iterator it;
+		TextList::const_iterator it;
 		glTranslatef(0.0, 0.0, -4900.0);
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->display();
 	}
 
 	void KeyboardMenu::animate() {
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->animate();
 	}
 
+	const char* KeyboardMenu::getName() const {
+		return "KeyboardMenu";
+	}
+
 	void KeyboardMenu::keyboard(unsigned char key, int x, int y) {
 		switch (key) {
-		case 13: delete graphics; graphics = new OptionsMenu(); break;
+		case 13: SceneManager::Switch(SceneManager::OPTIONS_MENU); break;
 		}
 	}
 	// -------------------- Class: KeyboardMenu --------------------
 
 	// -------------------- Class: Quit --------------------
-	Quit::Quit() {
+	Quit::Quit() : strs(&arena) {
 		selected = NO;
 		strs.push_back(Text("YES", Text::NORMAL, -500.0, 0.0));
 		strs.push_back(Text("NO", Text::NORMAL, 500.0, 0.0));
 		strs.push_back(Text("Are you sure?", Text::NORMAL, -550.0, 200.0));
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		it = strs.begin();
 		it->setColor(0.0, 1.0, 0.0);
 		++it;
@@ -1892,24 +2413,27 @@ namespace Graphics {
 		glTranslatef(100.0, 100.0, 0.0);
 		glRectf(-1000.0, -300.0, 1000.0, 300.0);
 		glPopMatrix();
-		std::list <Text>::const_iterator it;
+		TextList::const_iterator it;
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->display();
 		glPopMatrix();
 	}
 
 	void Quit::animate() {
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		for (it = strs.begin(); it != strs.end(); it++)
 			it->animate();
 	}
 
+	const char* Quit::getName() const {
+		return "Quit";
+	}
+
 	void Quit::keyboard(unsigned char key, int, int y) {
 		switch (key) {
 		case 13:
 			if (selected == NO) {
-				delete graphics;
-				graphics = new MainMenu();
+				SceneManager::Pop();
 			}
 			else
 				Application::Exit();
@@ -1918,7 +2442,7 @@ namespace Graphics {
 	}
 
 	void Quit::specialKeyboard(int key, int x, int y) {
-		std::list <Text>::iterator it;
+		TextList::iterator it;
 		switch (key) {
 		case GLUT_KEY_LEFT:
 			if (selected == YES)
@@ -1947,9 +2471,7 @@ namespace Graphics {
 	// -------------------- Class: Quit --------------------
 
 	// -------------------- Class: World --------------------
-	World::World(int character) : paused(false), hit(false), noHit(true), elapsedTime(0) {	// Create the World
-		glEnable(GL_LIGHTING);
-		Texture::Enable();
+	World::World(int character) : crowd(NULL), ghost(NULL), ghostPosition(0.0), paused(false), inputs(0), replaying(false) {	// Create the World
 		Audio::Load("background");
 		Audio::SetRepeat("background", true);
 		Audio::Play("background");
@@ -1957,62 +2479,70 @@ namespace Graphics {
 		Texture::Load("sand");
 		Texture::Load("sea");
 		Texture::Load("lilipad");
-		if (character == Character::BANANA_RUNNER)
-			this->character = new BananaRunner();
-		else if (character == Character::HUMAN_RUNNER)
-			this->character = new HumanRunner();
-		else if (character == Character::SKELETON_RUNNER)
-			this->character = new SkeletonRunner();
+		Texture::Load("gold");											// Kept while the scenery is baked with them
+		Texture::Load("black");
+		bake();
+		if (Replay::IsReplaying())
+			character = Replay::GetCharacter();
+		this->character = Runner::Create(character);
 		Tree::Load();
-		for (int i = -10; i < 10; i++) {
-			contentG.push_back(new Tree(i*500.0, -10.0, -300.0));
-		}
-		for (int i = -10; i < 10; i++) {
-			contentG.push_back(new Tree(i*500.0, -10.0, 100.0));
-		}
-		for (int i = -10; i < 0; i++) {
-			contentG.push_back(new Container(i*500.0, 25.0, 100.0));
-		}
-		for (int i = 0; i < 10; i++) {
-			contentG.push_back(new Container(i*500.0, 25.0, 100.0));
-		}
-		for (int i = -10; i < 10; i++) {
-			contentO.push_back(new Obstacle(i*750.0, 25.0, -50.0));
+		Container::Load();
+		Obstacle::Load();
+		course = nextCourse != NULL ? nextCourse : new Course(NextSeed());	// Take the course generated in the background
+		nextCourse = NULL;
+		Replay::Begin(course->getSeed(), character);
+		if (crowdRunners > 0) {
+			crowd = arena.create<Crowd>(crowdRunners, course->getSeed());
+			CrowdLists::Load();
 		}
-		path = new Path();
-		text = new Text(Text("Paused", Text::BLINKING_FADE, 0.0, 0.0));
-		textB = new Text(Text("HIT", Text::BLINKING_FADE, 0.0, 0.0));
+		track = arena.create<GhostTrack>();
+		track->setCharacter(character);
+		best = arena.create<GhostTrack>();
+		if (!Replay::IsReplaying() && best->load(ghostFile))			// No ghost during a replay - the best walk may have changed since
+			ghost = Runner::Create(best->getCharacter());				// Same kind of runner as the one of the best walk
+		racing = ghost != NULL;
+		simulation = arena.create<Simulation>(course);
+		pipeline = arena.create<Pipeline>([this](int inputs, int tick, FrameState& state) { step(inputs, tick, state); });
+		capture(pipeline->getFront());									// Displayed until the first step is collected
+		path = arena.create<Path>();
+		text = arena.create<Text>("Paused", Text::BLINKING_FADE, 0.0, 0.0);
+		textB = arena.create<Text>("HIT", Text::BLINKING_FADE, 0.0, 0.0);
 		textB->setColor(1.0, 0.0, 0.0);
 	}
 
 	World::~World() {													// Destroy the Wolrd
-		glDisable(GL_LIGHTING);
-		glDisable(GL_TEXTURE_2D);
+		Arena::Destroy(pipeline);										// Waits for the step in flight - the walk is left to this thread
+		Replay::End();
+		if (!Replay::IsReplaying() && track->getTraveled() > best->getTraveled())	// New best walk - a replay never replaces it
+			track->save(ghostFile);
+		if (crowd != NULL)
+			CrowdLists::Unload();
+		Arena::Destroy(crowd);
+		Arena::Destroy(track);
+		Arena::Destroy(best);
+		Runner::Destroy(ghost);
 		Audio::Unload("background");
 		Texture::Unload("cave");
 		Texture::Unload("sand");
 		Texture::Unload("sea");
-		Texture::Unload("wood");
 		Texture::Unload("lilipad");
-		delete path;
-		std::list <Object*>::iterator it;
-		for (it = contentG.begin(); it != contentG.end(); it++)
-			delete *it;
-		contentG.clear();
-		for (it = contentO.begin(); it != contentO.end(); it++)
-			delete *it;
-		contentO.clear();
+		glDeleteLists(scenery, BAKES);
+		Texture::Unload("gold");
+		Texture::Unload("black");
+		Arena::Destroy(path);											// Memory is released with the arena
+		Runner::Destroy(character);
+		Arena::Destroy(simulation);
+		delete course;
 		Tree::Unload();
-		delete text;
-		delete textB;
+		Container::Unload();
+		Obstacle::Unload();
+		Arena::Destroy(text);
+		Arena::Destroy(textB);
 	}
 
-	void World::display() const {										// Display World
-		glClearColor(0.0, 0.0, 0.0, 1.0);
-		glClearDepth(1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		glLoadIdentity();
-		camera.place();
+	void World::bake() {												// Compile the scenery that never moves into display lists - a call per group when displayed
+		scenery = glGenLists(BAKES);
+		glNewList(scenery + CAVE, GL_COMPILE);
 		// Display Cave
 		Texture::Use("cave");
 		specref[0] = 0.05375; specref[1] = 0.05; specref[2] = 0.06625; specref[3] = 1.0;
@@ -2030,6 +2560,8 @@ namespace Graphics {
 		gluSphere(quadric, zFar / 2.0, 25.0, 25.0);
 		gluQuadricOrientation(quadric, GLU_OUTSIDE);
 		glPopMatrix();
+		glEndList();
+		glNewList(scenery + SAND, GL_COMPILE);
 		// Display Terrain - Sand
 		Texture::Use("sand");
 		specref[0] = 0.2125; specref[1] = 0.1275; specref[2] = 0.054; specref[3] = 1.0;
@@ -2046,6 +2578,8 @@ namespace Graphics {
 		glRotatef(-90.0, 1.0, 0.0, 0.0);
 		gluDisk(quadric, 0.0, zFar / 2.0, 25.0, 25.0);
 		glPopMatrix();
+		glEndList();
+		glNewList(scenery + ROCKS, GL_COMPILE);
 		// Display the two golden statues - Base
 		Texture::Use("rock");
 		specref[0] = 0.05375; specref[1] = 0.05; specref[2] = 0.06625; specref[3] = 1.0;
@@ -2067,29 +2601,29 @@ namespace Graphics {
 		glRotatef(-30, 0.0, 1.0, 0.0);
 		Cube(250.0);
 		glPopMatrix();
-		// Display the two golden statues - Statue
-		Texture::Use("gold");
-		specref[0] = 0.24725; specref[1] = 0.2245; specref[2] = 0.0645; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
-		specref[0] = 0.34615; specref[1] = 0.3143; specref[2] = 0.0903; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_DIFFUSE, specref);
-		specref[0] = 0.797357; specref[1] = 0.723991; specref[2] = 0.208006; specref[3] = 1.0;
-		glMaterialfv(GL_FRONT, GL_SPECULAR, specref);
-		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 0.0;
-		glMaterialfv(GL_FRONT, GL_EMISSION, specref);
-		glMaterialf(GL_FRONT, GL_SHININESS, 83.2);
-		glPushMatrix();
-		glTranslatef(zFar / 2.0 - 500.0, -140.0, -550.0);
-		glRotatef(-180.0, 0.0, 1.0, 0.0);
-		glScalef(5.0, 5.0, 5.0);
-		HumanRunner::display(HumanRunner::STATUE_LEFT_HAND);
-		glPopMatrix();
-		glPushMatrix();
-		glTranslatef(zFar / 2.0 - 500.0, -140.0, 550.0);
-		glRotatef(-180.0, 0.0, 1.0, 0.0);
-		glScalef(5.0, 5.0, 5.0);
-		HumanRunner::display(HumanRunner::STATUE_RIGHT_HAND);
-		glPopMatrix();
+		glEndList();
+		for (int level = 0; level < Detail::LEVELS; level++) {			// The two golden statues are baked at every level of detail
+			for (int part = HumanRunner::GOLD_PARTS; part <= HumanRunner::BLACK_PARTS; part++) {	// A list per material, holding the parts of both statues
+				glNewList(scenery + (part == HumanRunner::GOLD_PARTS ? STATUES_GOLD : STATUES_BLACK) + level, GL_COMPILE);
+				HumanRunner::UseMaterial(part);
+				// Left statue
+				glPushMatrix();
+				glTranslatef(zFar / 2.0 - 500.0, -140.0, -550.0);
+				glRotatef(-180.0, 0.0, 1.0, 0.0);
+				glScalef(5.0, 5.0, 5.0);
+				HumanRunner::display(HumanRunner::STATUE_LEFT_HAND, Detail::GetDetail(level), part);
+				glPopMatrix();
+				// Right statue
+				glPushMatrix();
+				glTranslatef(zFar / 2.0 - 500.0, -140.0, 550.0);
+				glRotatef(-180.0, 0.0, 1.0, 0.0);
+				glScalef(5.0, 5.0, 5.0);
+				HumanRunner::display(HumanRunner::STATUE_RIGHT_HAND, Detail::GetDetail(level), part);
+				glPopMatrix();
+				glEndList();
+			}
+		}
+		glNewList(scenery + ENTRANCE, GL_COMPILE);
 		// Display Entrance
 		specref[0] = 0.0; specref[1] = 0.0; specref[2] = 0.0; specref[3] = 1.0;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
@@ -2106,6 +2640,9 @@ namespace Graphics {
 		glScalef(1.0, 2.0, 0.1);
 		gluSphere(quadric, 500.0, 25.0, 25.0);
 		glPopMatrix();
+		glEndList();
+		glNewList(scenery + LILIPADS, GL_COMPILE);
+		// Display the lily pads - Lily pads are flat, a single loop of the disk is enough
 		Texture::Use("lilipad");
 		specref[0] = 0.135; specref[1] = 0.2225; specref[2] = 0.1575; specref[3] = 0.95;
 		glMaterialfv(GL_FRONT, GL_AMBIENT, specref);
@@ -2119,30 +2656,25 @@ namespace Graphics {
 		glPushMatrix();
 		glTranslatef(800.0, -29.0, -850.0);
 		glRotatef(-90, 1.0, 0.0, 0.0);
-		gluDisk(quadric, 0.0, 50.0, 25.0, 25.0);
+		gluDisk(quadric, 0.0, 50.0, 30, 1);
 		glPopMatrix();
 		glPushMatrix();
 		glTranslatef(1500.0, -29.0, -1000.0);
 		glRotatef(-90, 1.0, 0.0, 0.0);
-		gluDisk(quadric, 0.0, 50.0, 25.0, 25.0);
+		gluDisk(quadric, 0.0, 50.0, 30, 1);
 		glPopMatrix();
 		glPushMatrix();
 		glTranslatef(-660.0, -29.0, -1350.0);
 		glRotatef(-90, 1.0, 0.0, 0.0);
-		gluDisk(quadric, 0.0, 50.0, 25.0, 25.0);
+		gluDisk(quadric, 0.0, 50.0, 30, 1);
 		glPopMatrix();
 		glPushMatrix();
 		glTranslatef(-930.0, -29.0, -850.0);
 		glRotatef(-90, 1.0, 0.0, 0.0);
-		gluDisk(quadric, 0.0, 50.0, 25.0, 25.0);
+		gluDisk(quadric, 0.0, 50.0, 30, 1);
 		glPopMatrix();
-		character->display();
-		path->display();
-		std::list <Object*>::const_iterator it;
-		for (it = contentG.begin(); it != contentG.end(); it++)
-			(*it)->display();
-		for (it = contentO.begin(); it != contentO.end(); it++)
-			(*it)->display();
+		glEndList();
+		glNewList(scenery + SEA, GL_COMPILE);
 		// Display Terrain - Sea - last because of blending
 		Texture::Use("sea");
 		specref[0] = 0.1; specref[1] = 0.18725; specref[2] = 0.1745; specref[3] = 0.7;
@@ -2159,6 +2691,54 @@ namespace Graphics {
 		glRotatef(-90.0, 1.0, 0.0, 0.0);
 		gluDisk(quadric, 0.0, zFar / 2.0, 50.0, 50.0);
 		glPopMatrix();
+		glEndList();
+	}
+
+	void World::display() const {										// Display World
+		PROFILE_ZONE("World::display");
+		glClearColor(0.0, 0.0, 0.0, 1.0);
+		glClearDepth(1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glLoadIdentity();
+		camera.place();
+		GLfloat eyeX, eyeY, eyeZ;
+		camera.getPosition(eyeX, eyeY, eyeZ);
+		Detail::SetEye(eyeX, eyeY, eyeZ);								// Details & impostors are chosen from it
+		glCallList(scenery + CAVE);
+		glCallList(scenery + SAND);
+		glCallList(scenery + ROCKS);
+		statues[0].select(5.0 * 40.0, zFar / 2.0 - 500.0, -140.0, -550.0);	// Levels of the statues are selected where they stand (scaled by 5)
+		statues[1].select(5.0 * 40.0, zFar / 2.0 - 500.0, -140.0, 550.0);
+		int level = statues[0].getLevel();								// Both statues at the finer of their levels
+		if (statues[1].getLevel() < level)
+			level = statues[1].getLevel();
+		glCallList(scenery + STATUES_BLACK + level);
+		glCallList(scenery + STATUES_GOLD + level);						// Last, as the entrance is displayed with "gold" bound
+		glCallList(scenery + ENTRANCE);
+		glCallList(scenery + LILIPADS);
+		const FrameState& frame = pipeline->getFront();					// The next step is simulated meanwhile
+		character->display();
+		if (ghost != NULL && fabs(ghostPosition) < zFar / 2.0) {
+			glEnable(GL_POLYGON_STIPPLE);								// Screen-door translucency - needs no sorting & leaves the runner's materials as they are
+			glPushMatrix();
+			glTranslatef(ghostPosition, 0.0, 100.0);					// On the other side of the path
+			ghost->setPosition(ghostPosition, 0.0, 100.0);
+			ghost->display();
+			glPopMatrix();
+			glDisable(GL_POLYGON_STIPPLE);
+		}
+		path->display();
+		if (crowd != NULL)
+			CrowdLists::Display(frame.crowd);
+		const EntityStore& entities = frame.scenery;
+		const GLfloat *posX = entities.getPositionsX(), *posY = entities.getPositionsY(), *posZ = entities.getPositionsZ();
+		const unsigned char* render = entities.getRenders();
+		for (int i = 0; i < entities.size(); i++)
+			renders[render[i]](posX[i], posY[i], posZ[i]);
+		const ObstacleRing& obstacles = frame.obstacles;
+		for (int i = 0; i < obstacles.size(); i++)
+			Obstacle::Display(obstacles.getPositionX(i), obstacles.getPositionY(i), obstacles.getPositionZ(i));
+		glCallList(scenery + SEA);										// Last because of blending
 		if (paused) {
 			Texture::Disable();
 			glDisable(GL_LIGHTING);
@@ -2174,7 +2754,7 @@ namespace Graphics {
 			Texture::Enable();
 			glEnable(GL_LIGHTING);
 		}
-		else if (hit) {
+		else if (frame.hit) {
 			Texture::Disable();
 			glDisable(GL_LIGHTING);
 			glTranslatef(500.0, 100.0, -150.0);
@@ -2183,65 +2763,97 @@ namespace Graphics {
 			Texture::Enable();
 			glEnable(GL_LIGHTING);
 		}
+		hud.update();
+		hud.display(frame.time, renderTime);							// Performance overlay - only if it is visible (the simulation overlaps the display)
 	}
 
 	void World::animate() {												// Animate World
-		if (paused) {													// If user paused it
-			text->animate();
-			return;														// do nothing
-		}
-		else if (hit) {
-			elapsedTime += Timer::GetElapsedTime();
-			textB->animate();
-			if (elapsedTime >= 3000) {
-				hit = false;
-				noHit = true;
-				elapsedTime = 0;
+		PROFILE_ZONE("World::animate");
+		if (pipeline->collect()) {										// Step started by the last animation step - displayed from now on
+			const FrameState& frame = pipeline->getFront();
+			character->setMotion(frame.runner);
+			if (ghost != NULL) {
+				if (frame.ghostRunning) {
+					ghost->setMotion(frame.ghost);
+					ghostPosition = frame.ghostPosition;
+				}
+				else {													// The best walk ended here
+					Runner::Destroy(ghost);
+					ghost = NULL;
+				}
 			}
-			return;
+			if (frame.events & Simulation::STEP)
+				Audio::Play("step");
+			if (frame.events & Simulation::LAND)
+				Audio::Play("fall");
+			if (frame.stood)
+				textB->animate();
+			else
+				path->animate(frame.runner.getSpeed());
 		}
-		else if (noHit) {
-			elapsedTime += Timer::GetElapsedTime();
-			if (elapsedTime >= 2000) {
-				noHit = false;
-				elapsedTime = 0;
-			}
+		int elapsedTime = Timer::GetElapsedTime();
+		if (!Replay::Tick(elapsedTime)) {								// Replay is over
+			Application::Exit();
+			return;
 		}
-		character->animate();											// Animate character
-		GLfloat speed = character->getSpeed();
-		GLfloat posX;
-		path->animate(speed);
-		std::list <Object*>::iterator it, itB;
-		for (it = contentO.begin(); it != contentO.end(); ) {
-			(*it)->animate(speed);
-			posX = (*it)->getPositionX();
-			if (posX <= 5.0 && posX >= -5.0 && !noHit) {
-				if (character->getHeight() < 30.0) {
-					hit = true;
-					//					for(itB = contentO.begin(); itB != contentO.end(); itB++) {
-					//						(*itB)->setPositionX((*itB)->getPositionX()-750.0);
-					//					}
-				}
-			}
-			else if (posX < -zFar / 2.0 - 500.0) {						// If content is out of view - re-add it!
-				(*it)->setPositionX(-posX);
-			}
-			it++;
+		int type, key;
+		replaying = true;
+		while (Replay::Next(type, key))									// Recorded keys go through the same handlers
+			if (type == Replay::KEYBOARD)
+				keyboard((unsigned char)key, 0, 0);
+			else
+				specialKeyboard(key, 0, 0);
+		replaying = false;
+		if (paused) {													// If user paused it
+			text->animate();
+			return;														// do nothing
 		}
-		for (it = contentG.begin(); it != contentG.end(); ) {
-			(*it)->animate(speed);
-			posX = (*it)->getPositionX();
-			if (posX < -zFar / 2.0 - 500.0) {							// If content is out of view - re-add it!
-				(*it)->setPositionX(-posX);
-			}
-			it++;
+		pipeline->start(inputs, elapsedTime);							// Simulated while this step is displayed
+		inputs = 0;
+	}
+
+	void World::step(int inputs, int tick, FrameState& state) {
+		bool hit = simulation->isHit();									// Runner stands still until the penalty is over
+		state.events = simulation->step(inputs, tick);
+		state.stood = hit;
+		track->record(tick, simulation->getTraveled(), simulation->getRunner());
+		if (crowd != NULL)												// The content stands still while the runner is hit
+			crowd->step(tick, simulation->isHit() ? 0.0f : simulation->getRunner().getSpeed(), simulation->getObstacles(), &ThreadPool::Shared());
+		if (racing) {
+			double traveled;
+			if (best->play(tick, traveled, state.ghost))				// Decoded in place - nothing is allocated
+				state.ghostPosition = traveled - simulation->getTraveled();
+			else
+				racing = false;
 		}
+		capture(state);
+	}
+
+	void World::capture(FrameState& state) const {
+		state.runner = simulation->getRunner();
+		state.scenery = simulation->getScenery();						// Assigned into the buffers of the last copy - nothing is allocated once they are large enough
+		state.obstacles = simulation->getObstacles();
+		if (crowd != NULL)
+			state.crowd = *crowd;
+		state.traveled = simulation->getTraveled();
+		state.hit = simulation->isHit();
+		state.ghostRunning = racing;
+	}
+
+	const char* World::getName() const {
+		return "World";
 	}
 
 	void World::keyboard(unsigned char key, int x, int y) {
+		if (key != 27 && key != 'e') {									// Leaving the walk is neither recorded nor replayed
+			if (Replay::IsReplaying() && !replaying)					// Keys of the player are ignored during a replay
+				return;
+			Replay::Event(Replay::KEYBOARD, key);
+		}
 		switch (key) {
 		case 'P': case 'p':												// P or p -> Pause/Continue game
 			paused = !paused; Audio::SetPaused("background", paused); break;
+		case 'H': case 'h': hud.toggle(); break;						// H or h -> Show/Hide performance overlay
 		case '8': camera.moveUp(); break;								// 8 -> Move camera Up - Y Axis
 		case '5': camera.moveDown(); break;								// 5 -> Move camera Down - Y Axis
 		case '4': camera.moveLeft(); break;								// 4 -> Move Camera Left - X Axis
@@ -2249,51 +2861,75 @@ namespace Graphics {
 		case '-': camera.zoomOut(); break;								// - -> Move Camera Away - Z Axis
 		case '+': camera.zoomIn(); break;								// + -> Move Camera Closer - Z Axis
 		case 27:
-			pauseWalk();
+			SceneManager::Push(SceneManager::MAIN_MENU);				// Escape -> Pause walk & show main menu above it
 			break;
 		case 32:														// Space -> jump
 			if (!paused)
-				character->jump();
+				inputs |= Simulation::JUMP;
 			break;
 		case 'e': Application::Exit(); break;							// 'e' -> Terminates program
 		}
 	}
 
 	void World::specialKeyboard(int key, int x, int y) {
-		if (!paused && !hit)											// If game is not paused or user has failed to pass obstacle - else these keys are "disabled"
+		if (Replay::IsReplaying() && !replaying)
+			return;
+		Replay::Event(Replay::SPECIAL_KEYBOARD, key);
+		if (!paused)													// If game is not paused - a runner that has failed to pass an obstacle ignores them in Simulation::step
 			switch (key) {
 			case GLUT_KEY_UP:											// Arrow key Up - Increase Speed
-				character->speedUp();
+				inputs |= Simulation::SPEED_UP;
 				break;
 			case GLUT_KEY_DOWN:
-				character->slowDown();									// Arrow key Down - Slow Down
+				inputs |= Simulation::SLOW_DOWN;						// Arrow key Down - Slow Down
 				break;
 			}
 	}
 
-	void World::continueWalk() {										// When user continues his last walk - stops main menu & continues walk
+	void World::Preload() {
+		if (!preloaded) {
+			Audio::Preload("background");
+			for (unsigned i = 0; i < sizeof(worldTextures) / sizeof(worldTextures[0]); i++)
+				Texture::Preload(worldTextures[i]);
+			Wavefront::Preload("tree");
+			preloaded = true;
+		}
+		if (nextCourse == NULL)
+			nextCourse = new Course(NextSeed());						// Its worker starts generating the first chunks right away
+	}
+
+	bool World::IsLoading() {
+		if (Audio::IsLoading("background") || Wavefront::IsLoading("tree"))
+			return true;
+		for (unsigned i = 0; i < sizeof(worldTextures) / sizeof(worldTextures[0]); i++)
+			if (Texture::IsLoading(worldTextures[i]))
+				return true;
+		return false;
+	}
+
+	void World::Unload() {
+		if (preloaded) {
+			Audio::Unload("background");
+			for (unsigned i = 0; i < sizeof(worldTextures) / sizeof(worldTextures[0]); i++)
+				Texture::Unload(worldTextures[i]);
+			Wavefront::Unload("tree");
+			preloaded = false;
+		}
+		delete nextCourse;
+		nextCourse = NULL;
+	}
+
+	void World::onEnter() {												// When the walk starts or is continued from the main menu
 		Audio::SetPaused("main_theme", true);
 		Audio::SetPaused("background", false);
 		glEnable(GL_LIGHTING);
 		Texture::Enable();
-		delete graphics;
-		graphics = lastRace;
-		if (character->getKindOf() == Character::HUMAN_RUNNER)
-			Texture::Load("skin");
-		else if (character->getKindOf() == Character::BANANA_RUNNER)
-			Texture::Load("banana_skin");
-		else if (character->getKindOf() == Character::SKELETON_RUNNER)
-			Texture::Load("gold");
-		Texture::Load("black");
 	}
 
-	void World::pauseWalk() {											// When user presses escape - pause walk & returns to main menu
-		lastRace = this;
+	void World::onExit() {												// When user presses escape - the walk is paused below the main menu
 		Audio::SetPaused("background", true);
-		Audio::SetPaused("main_theme", false);
 		glDisable(GL_LIGHTING);
 		Texture::Disable();
-		graphics = new MainMenu();
 	}
 	// -------------------- Class: World --------------------
 }
@@ -26,9 +26,20 @@
 # define __GRAPHICS__
 
 # include <list>														// List
+# include <string>														// String
+# include <unordered_map>												// Hash Map
+# include <vector>														// Vector
 
 # include "gl\glut.h"													// OpenGL Utility Toolkit
 
+# include "arena.h"
+# include "course.h"
+# include "crowd.h"
+# include "entities.h"
+# include "ghost.h"
+# include "pipeline.h"
+# include "simulation.h"
+
 // -------------------- Class: Camera --------------------
 class Camera {															// Camera - Controls the view of the scene
 public:
@@ -43,6 +54,7 @@ public:
 	void lookAt(GLfloat centerX, GLfloat centerY, GLfloat centerZ);		// Set cameras point of interest, where camera looks at
 
 	void place() const;													// Place camera in the scene
+	void getPosition(GLfloat& x, GLfloat& y, GLfloat& z) const;			// Position of the camera in the scene (where place puts the eye)
 
 private:
 	const GLfloat angleChange;											// Value of cameras movement speed
@@ -51,6 +63,33 @@ private:
 };
 // -------------------- Class: Camera --------------------
 
+// -------------------- Class: Detail --------------------
+class Detail {															// Slices & stacks of quadrics chosen from their size on screen - each object keeps its own level, so it doesn't flicker
+public:
+	Detail();
+
+	GLint select(GLfloat radius, GLfloat posX, GLfloat posY, GLfloat posZ);	// Detail of an object of radius at the given position (in the units of the eye)
+	int getLevel() const;												// Level selected last (0 is the finest)
+
+	static void SetViewport(int height);								// Height of the window (in pixels)
+	static void SetEye(GLfloat x, GLfloat y, GLfloat z);				// Position of the camera the objects are displayed from (set by each scene)
+	static const GLfloat* GetEye();
+	static GLfloat Distance(GLfloat posX, GLfloat posY, GLfloat posZ);	// From the eye to a position
+	static GLint GetDetail(int level);									// Slices & stacks of a level
+
+	static const int LEVELS = 5;
+
+private:
+	int level;															// Level selected last - a level changes only when the size is clearly past its limit
+
+	static const GLint details[LEVELS];									// From the finest to the coarsest
+	static const GLfloat sizes[LEVELS - 1];								// Smallest radius on screen of each level (in pixels)
+	static const GLfloat HYSTERESIS;									// Fraction a size has to be past a limit to change level
+	static GLfloat pixelsPerUnit;										// Pixels of a unit at distance 1 from the camera
+	static GLfloat eye[3];
+};
+// -------------------- Class: Detail --------------------
+
 // -------------------- Class: Character --------------------
 class Character {														// Abstract class - Classes Implementing this are in Graphics.cpp
 public:
@@ -69,31 +108,23 @@ public:
 	Runner();
 	~Runner();
 
-	virtual void animate();
+	virtual void animate();												// Move on its own (in the menus)
+	void setMotion(const Motion& motion);								// Show the given motion (the runner of a walk is moved by its simulation)
+	void setDetail(int detail) { fixedDetail = detail; }				// Slices & stacks of the quadrics of its body (0: chosen from its size on screen - the default)
+	void setPosition(GLfloat x, GLfloat y, GLfloat z);					// Where it is displayed - its size on screen is found from it (at the origin by default)
 
-	void speedUp();
-	void slowDown();
-	void jump();
-	GLfloat getSpeed() const;
 	virtual int getKindOf() const = 0;
 
-	GLfloat getHeight() const;
+	static Runner* Create(int kind);									// Take a runner of the given kind from its pool
+	static void Destroy(Runner* runner);								// Give runner back to its pool
 
 protected:
-	GLfloat rotationH, rotationL;										// Rotation for hight & low part of hands & legs
-	GLfloat height;														// Human's distance from ground (when jumping-falling)
+	Motion motion;														// Speed, jump & the swing of arms/legs
+	GLint getDetail() const;											// Slices & stacks to display it with
 
-private:
-	GLfloat speed;														// Runners current moving speed
-	const GLfloat speedChange, minSpeed, maxSpeed;						// Value of speed change each time user speeds up/slows down, and minimum/maximum speed
-	GLfloat jumpHeight;													// How hight runner jumps, depends on the speed at that time
-
-	int move;															// runners current move
-	enum movement														// Enumeration with all possible movements the runner can perform
-	{
-		LEFT_ARM_FRONT, RIGHT_ARM_FRONT,
-		JUMP_UP_LEFT_ARM_FRONT, JUMP_UP_RIGHT_ARM_FRONT, JUMP_DOWN_LEFT_ARM_FRONT, JUMP_DOWN_RIGHT_ARM_FRONT,
-	};
+	int fixedDetail;
+	GLfloat position[3];
+	mutable Detail lod;
 };
 // -------------------- Class: Runner  --------------------
 
@@ -138,6 +169,9 @@ public:
 
 	const char* getText() const;
 
+	static void displayCached(const char* str);							// Display any string using the cached geometry of the font's characters
+	static void Unload();												// Free the captured geometry of all fonts
+
 	static void* font;
 
 	enum Styles { NORMAL, APPEAR, APPEAR_ROTATE_Y, MOVE_RIGHT, MOVE_LEFT, BLINKING_FADE, BLINKING_APPEAR };
@@ -148,14 +182,54 @@ private:
 	GLfloat r, g, b;
 	int style;
 	bool fade;
+	const std::vector <GLfloat>* vertices;								// Line segments (x, y) of the whole string - shared by all texts of the same string
+
+	class Glyphs {														// Geometry of every character of a font
+	public:
+		std::vector <GLfloat> vertices;									// Line segments (x, y) of all characters
+		GLint first[128], count[128];									// Vertices of each character
+		GLfloat advance[128];											// Width of each character
+	};
+
+	static const Glyphs& GetGlyphs();									// Geometry of the current font - captured once from GLUT with feedback mode
+	static void Build(const char* str, std::vector <GLfloat>& vertices);	// Append the characters of the string one after the other
+	static const std::vector <GLfloat>& GetRun(const char* str);		// Line segments of the whole string - built once per string
+	static void Draw(const std::vector <GLfloat>& vertices);
+
+	static std::unordered_map <void*, Glyphs> fonts;					// Hash map with the geometry of all used fonts
+	static std::unordered_map <std::string, std::vector <GLfloat> > runs;	// Hash map with the line segments of all displayed strings (menus rebuild the same ones)
 };
 // -------------------- Class: Text --------------------
 
+// -------------------- Class: Hud --------------------
+class Hud {																// Performance overlay - drawn in screen space on top of the scene
+public:
+	Hud();
+
+	void display(double simulationTime, double renderTime) const;		// Display overlay with the last measured times (in milliseconds)
+	void update();														// Measure the time since the previous frame - called once per frame
+
+	void toggle();														// Show/Hide overlay
+	bool isVisible() const;
+
+private:
+	enum { SAMPLES = 120 };												// Frames shown in the frame time graph
+	GLfloat graph[SAMPLES * 2];											// Vertices of the frame time graph (oldest frame first)
+	double frameTimes[SAMPLES];
+	double lastFrame;
+	double lastSample;													// When the utilization of the pool's workers was sampled
+	double utilization;
+	int current;
+	bool visible;
+};
+// -------------------- Class: Hud --------------------
+
 // -------------------- Namespace: Graphics --------------------
 namespace Graphics {
 	// -------------------- Basic functions used by glut when each specific event occurs --------------------
 	void Init();														// Initialize Graphics Library
 	void Exit();														// Clean up Graphics Library
+	void SetCrowd(int runners);											// AI runners sharing the course of the next walks (0: none - the default)
 
 	void reshape(int width, int height);								// Main reshape callback function
 	void display();														// Main display callback function
@@ -178,12 +252,50 @@ namespace Graphics {
 
 		virtual void display() const = 0 {}
 		virtual void animate() = 0 {}
+		virtual const char* getName() const = 0;						// Name of the scene (frame statistics are kept per scene)
 
 		virtual void keyboard(unsigned char key, int x, int y) {}
 		virtual void specialKeyboard(int key, int x, int y) {}
+
+		virtual void onEnter() {}										// Scene becomes the current one (GL & audio state it needs)
+		virtual void onExit() {}										// Scene stops being the current one - it may be entered again later
+
+	protected:
+		Arena arena;													// Memory of the scene's containers & objects - released at once when the scene is destroyed
 	};
+
+	typedef std::list <Text, ArenaAllocator<Text> > TextList;			// List of texts in the arena of a scene
+	typedef std::list <Runner*, ArenaAllocator<Runner*> > RunnerList;
 	// -------------------- Class: Graphics --------------------
 
+	// -------------------- Class: SceneManager --------------------
+	class World;
+
+	class SceneManager {												// Stack of live scenes - the menus are created once & kept, so navigating between them is a pointer swap
+	public:
+		enum Scenes { INTRO, MAIN_MENU, NEW_GAME_MENU, OPTIONS_MENU, SOUND_MENU, KEYBOARD_MENU, QUIT, SCENES };
+
+		static void Init();												// Start with the intro
+		static void Exit();												// Destroy all scenes
+
+		static Graphics* Current();										// Scene on top of the stack - the one displayed & receiving input
+		static void Switch(int scene);									// Replace the current scene with the given one
+		static void Push(int scene);									// Show the given scene above the current one - which stays alive below it
+		static void Pop();												// Remove the current scene & return to the one below it
+
+		static void Start(int character);								// Start a new walk - the paused walk (if any) is destroyed
+		static bool HasPausedWalk();									// true: a walk is kept below the menus & can be continued
+
+	private:
+		static Graphics* Get(int scene);								// Kept instance of a scene - created the first time it is needed
+		static void Leave();											// Remove the current scene from the stack
+
+		static Graphics* scenes[SCENES];
+		static std::vector <Graphics*> stack;
+		static World* walk;												// Last walk started (NULL if none)
+	};
+	// -------------------- Class: SceneManager --------------------
+
 	// -------------------- Class: Intro --------------------
 	class Intro : public Graphics {
 	public:
@@ -192,11 +304,15 @@ namespace Graphics {
 
 		virtual void display() const;
 		virtual void animate();
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int x, int y);
 
+		virtual void onEnter();
+		virtual void onExit();
+
 	private:
-		std::list<Text> strs;
+		TextList strs;
 		double elapsedTime;
 	};
 	// -------------------- Class: Intro --------------------
@@ -209,12 +325,16 @@ namespace Graphics {
 
 		virtual void display() const;
 		virtual void animate();
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int x, int y);
 		virtual void specialKeyboard(int key, int x, int y);
 
+		virtual void onEnter();
+		virtual void onExit();
+
 	private:
-		std::list<Text> strs;
+		TextList strs;
 		enum Selects { NEW_GAME, CONTINUE, OPTIONS, REPLAY_INTRO, QUIT, NONE };
 		double elapsedTime;
 		int selected;
@@ -230,15 +350,21 @@ namespace Graphics {
 
 		virtual void display() const;
 		virtual void animate();
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int x, int y);
 		virtual void specialKeyboard(int key, int x, int y);
 
+		virtual void onEnter();
+		virtual void onExit();
+
 	private:
-		std::list<Text> strs;
+		TextList strs;
 		enum Selects { MAIN_MENU, SELECT_CHARACTER, START_GAME, CHOOSING_CHARACTER };
 		int selected;
-		std::list<Runner*> characters;
+		RunnerList characters;
+		Text* loading;
+		bool starting;													// Start Game was chosen while the walk was still being preloaded
 	};
 	// -------------------- Class: NewGameMenu --------------------
 
@@ -250,12 +376,16 @@ namespace Graphics {
 
 		virtual void display() const;
 		virtual void animate();
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int x, int y);
 		virtual void specialKeyboard(int key, int x, int y);
 
+		virtual void onEnter();
+		virtual void onExit();
+
 	private:
-		std::list<Text> strs;
+		TextList strs;
 		enum selects { SOUND, KEYBOARD, MAIN_MENU };
 		int selected;
 	};
@@ -269,15 +399,19 @@ namespace Graphics {
 
 		virtual void display() const;
 		virtual void animate();
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int x, int y);
 		virtual void specialKeyboard(int key, int x, int y);
 
+		virtual void onEnter();
+		virtual void onExit();
+
 	private:
 		enum selects { INCREASE_VOLUME, DECREASE_VOLUME, OPTIONS };
 		int selected;
 
-		std::list<Text> strs;
+		TextList strs;
 	};
 	// -------------------- Class: SoundMenu --------------------
 
@@ -289,11 +423,15 @@ namespace Graphics {
 
 		virtual void display() const;
 		virtual void animate();
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int x, int y);
 
+		virtual void onEnter();
+		virtual void onExit();
+
 	private:
-		std::list<Text> strs;
+		TextList strs;
 	};
 	// -------------------- Class: KeyboardMenu --------------------
 
@@ -304,12 +442,13 @@ namespace Graphics {
 
 		virtual void display() const;
 		virtual void animate();
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int, int y);
 		virtual void specialKeyboard(int key, int x, int y);
 
 	private:
-		std::list<Text> strs;
+		TextList strs;
 		enum Selects { YES, NO };
 		int selected;
 	};
@@ -323,25 +462,44 @@ namespace Graphics {
 
 		virtual void display() const;									// Display World
 		virtual void animate();											// Animate World
+		virtual const char* getName() const;
 
 		virtual void keyboard(unsigned char key, int x, int y);
 		virtual void specialKeyboard(int key, int x, int y);
 
-		void continueWalk();											// When user continues his last walk - stops main menu & continues walks
-		void pauseWalk();												// When user presses escape - pause walk & returns to main menu
+		static void Preload();											// Start loading the assets of a walk & generating its course in the background - kept for the next walks
+		static bool IsLoading();										// Check if the preloaded assets aren't ready yet
+		static void Unload();											// Release the assets kept by Preload
+
+		virtual void onEnter();											// When the walk starts or is continued from the main menu
+		virtual void onExit();											// When user presses escape - the walk is paused below the main menu
 
 	private:
+		enum Bakes { CAVE, SAND, ROCKS, STATUES_GOLD, STATUES_BLACK = STATUES_GOLD + Detail::LEVELS, ENTRANCE = STATUES_BLACK + Detail::LEVELS, LILIPADS, SEA, BAKES };
+
+		void bake();													// Compile the scenery into its display lists - one per material group (& per level of the statues)
+		void step(int inputs, int tick, FrameState& state);				// Advance the walk & write what is displayed of it (on the pipeline's thread)
+		void capture(FrameState& state) const;							// Write what is displayed of the walk
+
 		Camera camera;													// Worlds camera
-		Runner* character;												// User's character (a runner)
-		std::list<Object*> contentG;									// Worlds content - general
-		std::list<Object*> contentO;									// Worlds content - obstacles
+		Runner* character;												// User's character (a runner) - shows the runner of the simulation
+		Crowd* crowd;													// AI runners (NULL if not in crowd mode)
+		Runner* ghost;													// Best walk so far - runs translucently next to the character (NULL if none)
+		GhostTrack *track, *best;										// Recording of this walk & of the best one (raced by the ghost)
+		double ghostPosition;											// Distance of the ghost in front of the character
+		bool racing;													// The best walk is still being played (only used by the pipeline's thread)
+		Simulation* simulation;											// Rules of the walk - the World only displays its state
+		Pipeline* pipeline;												// Steps the simulation, crowd & ghost while the last step is displayed
+		Course* course;													// Generates the content chunk by chunk
 		Object *path;
 		Text *text, *textB;
+		mutable Detail statues[2];										// Level of detail of the golden statues
+		GLuint scenery;													// Display lists of the scenery that never moves (see Bakes)
+		mutable Hud hud;												// Performance overlay - measures each displayed frame
 
 		bool paused;													// true: World paused, false: otherwise
-		int elapsedTime;
-		bool hit;
-		bool noHit;
+		int inputs;														// Keys pressed since the last animation step (see Simulation::Inputs)
+		bool replaying;													// true: The keys handled are fed from the replay
 	};
 	// -------------------- Class: World --------------------
 }
@@ -0,0 +1,90 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <chrono>
+
+# include "pipeline.h"
+# include "utilities.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+static void Wait(const std::atomic<unsigned>& counter, unsigned value, const std::atomic<bool>* stop = NULL) {	// Wait until counter reaches value - no locks are taken
+	for (int spins = 0; counter.load(std::memory_order_acquire) != value; spins++) {
+		if (stop != NULL && stop->load(std::memory_order_acquire))
+			return;
+		if (spins < 1000)												// A step is shorter than a frame - it is usually close
+			std::this_thread::yield();
+		else															// Paused or in the menus - don't keep a core busy
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Class: FrameState --------------------
+FrameState::FrameState() : crowd(0, 0u), traveled(0.0), ghostPosition(0.0), time(0.0), events(0), hit(false), stood(false), ghostRunning(false) {
+}
+// -------------------- Class: FrameState --------------------
+
+// -------------------- Class: Pipeline --------------------
+Pipeline::Pipeline(Step step) : step(step), front(0), inputs(0), tick(0), requested(0), completed(0), stop(false) {
+	thread = std::thread(&Pipeline::run, this);
+}
+
+Pipeline::~Pipeline() {
+	collect();
+	stop.store(true, std::memory_order_release);
+	thread.join();
+}
+
+void Pipeline::start(int inputs, int tick) {
+	this->inputs = inputs;
+	this->tick = tick;
+	requested.fetch_add(1, std::memory_order_release);					// The arguments are visible to the pipeline's thread from here on
+}
+
+bool Pipeline::collect() {
+	unsigned last = requested.load(std::memory_order_relaxed);			// Only changed by this thread
+	if (completed.load(std::memory_order_acquire) == last)
+		return false;
+	PROFILE_ZONE("Pipeline::collect");
+	Wait(completed, last);
+	front = 1 - front;													// The state just written is displayed - the old one is written next
+	return true;
+}
+
+void Pipeline::run() {
+	for (unsigned done = 0; ; ) {
+		Wait(requested, done + 1, &stop);
+		if (stop.load(std::memory_order_acquire))
+			return;
+		FrameState& state = states[1 - front];							// front isn't changed while a step is in flight
+		double start = Timer::GetTime();
+		step(inputs, tick, state);
+		state.time = Timer::GetTime() - start;
+		completed.store(++done, std::memory_order_release);				// Hands the state over to the displaying thread
+	}
+}
+// -------------------- Class: Pipeline --------------------
\ No newline at end of file
@@ -0,0 +1,88 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __PIPELINE__
+# define __PIPELINE__
+
+# include <atomic>
+# include <functional>
+# include <thread>
+
+# include "crowd.h"
+# include "entities.h"
+# include "simulation.h"
+
+// -------------------- Class: FrameState --------------------
+class FrameState {														// What is displayed of a walk after a step - copied out, so the next step can be simulated while it is displayed
+public:
+	FrameState();
+
+	Motion runner;
+	Motion ghost;														// Pose of the best walk (if ghostRunning)
+	EntityStore scenery;
+	ObstacleRing obstacles;
+	Crowd crowd;														// Empty if not in crowd mode
+	double traveled;
+	double ghostPosition;												// Distance of the ghost in front of the runner
+	double time;														// Time spent simulating the step (in milliseconds)
+	int events;															// Events of the step (see Simulation::Events)
+	bool hit;															// Runner is hit after the step
+	bool stood;															// Runner stood still during the step (was hit before it)
+	bool ghostRunning;													// false: the best walk has ended (or there is none)
+};
+// -------------------- Class: FrameState --------------------
+
+// -------------------- Class: Pipeline --------------------
+class Pipeline {														// Steps a walk on a thread of its own into one of two frame states - the other one is displayed meanwhile
+public:
+	typedef std::function<void(int inputs, int tick, FrameState& state)> Step;	// Advances the walk & writes its state (called on the pipeline's thread)
+
+	Pipeline(Step step);
+	~Pipeline();														// Waits for the step in flight
+
+	void start(int inputs, int tick);									// Simulate the next step into the back state (the last step has to be collected)
+	bool collect();														// Wait for the step in flight - its state becomes the front one (false: none was in flight)
+
+	FrameState& getFront() { return states[front]; }					// State to be displayed - only to be used by the thread starting the steps
+	const FrameState& getFront() const { return states[front]; }
+
+private:
+	void run();															// Loop of the pipeline's thread
+
+	Step step;
+	FrameState states[2];
+	int front;															// State not touched by the pipeline's thread
+	int inputs, tick;													// Arguments of the requested step - published by requested
+	std::atomic<unsigned> requested;									// Steps requested & completed - a step is in flight while they differ
+	std::atomic<unsigned> completed;
+	std::atomic<bool> stop;
+	std::thread thread;
+
+	Pipeline(const Pipeline&);
+	Pipeline& operator=(const Pipeline&);
+};
+// -------------------- Class: Pipeline --------------------
+
+# endif  // # ifndef __PIPELINE__
\ No newline at end of file
@@ -0,0 +1,86 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __POOL__
+# define __POOL__
+
+# include <new>															// Placement new
+# include <type_traits>													// Aligned storage
+# include <utility>														// Forward
+
+// -------------------- Class: Pool --------------------
+template <class T, int N>
+class Pool {															// N objects of type T in one contiguous block - acquire & release are O(1) & never touch the heap
+public:
+	Pool() : firstFree(0), used(0) {
+		for (int i = 0; i < N; i++)										// Every slot links to the next free one
+			nextFree[i] = i + 1;
+	}
+
+	~Pool() {}															// Objects still acquired are not destroyed - release them first
+
+	template <class... Args>
+	T* acquire(Args&&... args) {										// Construct an object in a free slot - from the heap if the pool is exhausted
+		if (firstFree == N)
+			return new T(std::forward<Args>(args)...);
+		int slot = firstFree;
+		firstFree = nextFree[slot];
+		used++;
+		return new (&slots[slot]) T(std::forward<Args>(args)...);
+	}
+
+	void release(T* object) {											// Destroy the object & give back its slot
+		if (!owns(object)) {											// Came from the heap
+			delete object;
+			return;
+		}
+		int slot = (int)(reinterpret_cast<Storage*>(object) - slots);
+		object->~T();
+		nextFree[slot] = firstFree;
+		firstFree = slot;
+		used--;
+	}
+
+	bool owns(const T* object) const {
+		const Storage* storage = reinterpret_cast<const Storage*>(object);
+		return storage >= slots && storage < slots + N;
+	}
+
+	int getUsed() const { return used; }								// Slots currently in use
+
+private:
+	typedef typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type Storage;
+
+	Storage slots[N];
+	int nextFree[N];													// Free list - linked through the indices of the slots
+	int firstFree;														// N if none is free
+	int used;
+
+	Pool(const Pool&);													// Objects live in the pool - it can't be copied
+	Pool& operator=(const Pool&);
+};
+// -------------------- Class: Pool --------------------
+
+# endif  // # ifndef __POOL__
\ No newline at end of file
@@ -0,0 +1,182 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+# include <atomic>
+# include <chrono>
+# include <cstddef>
+# include <fstream>
+# include <iostream>
+# include <string>
+
+# include "profiler.h"
+
+// -------------------- Namespace: Profiler --------------------
+namespace Profiler {
+	static const int MAX_THREADS = 64;									// Threads profiled at once - a thread that exits gives its buffer to the next one
+	static const int MAX_DEPTH = 64;
+	static const unsigned int RING_SIZE = 65536;						// Zones kept per thread (must be a power of 2) - oldest zones are overwritten
+
+	typedef struct Event {
+		const char* zone;
+		long long start, duration;										// In nanoseconds since the profiler was initialized (value for counters)
+		int depth;														// Nesting of the zone (-1 for counters)
+	} Event;
+
+	class Buffer {														// Ring buffer of a single thread - only the owner thread writes to it, so no locking is needed
+	public:
+		Event events[RING_SIZE];
+		std::atomic<unsigned int> written;								// Total number of zones ever written (published after the event is stored)
+		const char* zones[MAX_DEPTH];									// Currently opened zones of the thread
+		long long starts[MAX_DEPTH];
+		int depth;
+		int thread;
+		std::atomic<bool> used;											// Owned by a live thread
+	};
+
+	class Owner {														// Buffer of a thread - given back when the thread exits
+	public:
+		Owner() : buffer(NULL) {}
+		~Owner() {
+			if (buffer != NULL)
+				buffer->used.store(false, std::memory_order_release);
+		}
+
+		Buffer* buffer;
+	};
+
+	static std::chrono::high_resolution_clock::time_point epoch = std::chrono::high_resolution_clock::now();	// Reset by Init - zones of headless runs are timed from the start of the program
+	static std::atomic<Buffer*> buffers[MAX_THREADS];					// Buffers of the threads that opened a zone - reused once their thread has exited
+	static std::atomic<int> threads(0);
+	static thread_local Owner owner;									// Ring buffer of the calling thread
+	static std::string output = "profile.json";
+
+	static long long Now() {											// Nanoseconds since the profiler was initialized
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - epoch).count();
+	}
+
+	static Buffer* Register() {											// Take the ring buffer of an exited thread or create one for the calling thread
+		int count = threads.load() < MAX_THREADS ? threads.load() : MAX_THREADS;
+		for (int i = 0; i < count; i++) {
+			Buffer* freeBuffer = buffers[i].load(std::memory_order_acquire);
+			bool used = false;
+			if (freeBuffer != NULL && freeBuffer->used.compare_exchange_strong(used, true)) {	// Zones of the exited thread are kept - the trace shows them on the same row
+				freeBuffer->depth = 0;
+				return owner.buffer = freeBuffer;
+			}
+		}
+		int thread = threads.fetch_add(1);
+		if (thread >= MAX_THREADS)
+			return NULL;
+		Buffer* newBuffer = new Buffer();
+		newBuffer->written = 0;
+		newBuffer->depth = 0;
+		newBuffer->thread = thread;
+		newBuffer->used = true;
+		buffers[thread].store(newBuffer, std::memory_order_release);
+		return owner.buffer = newBuffer;
+	}
+
+	void Init() {														// Initialize Profiler Library
+		epoch = std::chrono::high_resolution_clock::now();
+		std::cout << "Initialized Profiler Library.." << std::endl;
+	}
+
+	void Exit() {														// Clean up Profiler Library
+		std::cout << "Cleaned Profiler Library.." << std::endl;
+	}
+
+	void Begin(const char* zone) {										// Open a named zone on the calling thread
+		Buffer* buffer = owner.buffer != NULL ? owner.buffer : Register();
+		if (buffer == NULL)
+			return;
+		if (buffer->depth < MAX_DEPTH) {
+			buffer->zones[buffer->depth] = zone;
+			buffer->starts[buffer->depth] = Now();
+		}
+		buffer->depth++;
+	}
+
+	static void Record(Buffer* buffer, const char* zone, long long start, long long duration, int depth) {	// Publish an event in the ring buffer of the calling thread
+		unsigned int written = buffer->written.load(std::memory_order_relaxed);
+		Event& event = buffer->events[written & (RING_SIZE - 1)];
+		event.zone = zone;
+		event.start = start;
+		event.duration = duration;
+		event.depth = depth;
+		buffer->written.store(written + 1, std::memory_order_release);
+	}
+
+	void End() {														// Close the last opened zone of the calling thread
+		Buffer* buffer = owner.buffer;
+		if (buffer == NULL || buffer->depth == 0)
+			return;
+		buffer->depth--;
+		if (buffer->depth >= MAX_DEPTH)									// Zone was too deep to be recorded
+			return;
+		long long start = buffer->starts[buffer->depth];
+		Record(buffer, buffer->zones[buffer->depth], start, Now() - start, buffer->depth);
+	}
+
+	void Counter(const char* counter, long long value) {				// Record the value of a named counter at this moment
+		Buffer* buffer = owner.buffer != NULL ? owner.buffer : Register();
+		if (buffer == NULL)
+			return;
+		Record(buffer, counter, Now(), value, -1);
+	}
+
+	void SetOutput(std::string file) {									// Set file where the recorded zones are written
+		output = file;
+	}
+
+	bool Dump() {														// Write the recorded zones of all threads as Chrome trace_event JSON
+		std::ofstream file(output);
+		if (!file.is_open()) {
+			std::cerr << "Cannot write profile: " << output << std::endl;
+			return false;
+		}
+		int zones = 0, count = threads.load() < MAX_THREADS ? threads.load() : MAX_THREADS;
+		file << "{\"traceEvents\":[";
+		file.setf(std::ios::fixed);
+		file.precision(3);
+		for (int i = 0; i < count; i++) {
+			Buffer* thread = buffers[i].load(std::memory_order_acquire);
+			if (thread == NULL)											// Thread is still registering
+				continue;
+			unsigned int written = thread->written.load(std::memory_order_acquire);
+			unsigned int first = written > RING_SIZE ? written - RING_SIZE : 0;
+			for (unsigned int j = first; j < written; j++) {			// Zones being overwritten while dumping may appear truncated
+				const Event& event = thread->events[j & (RING_SIZE - 1)];
+				file << (zones++ == 0 ? "\n" : ",\n") << "{\"name\":\"" << event.zone << "\",\"ts\":" << event.start / 1000.0 << ",\"pid\":1,\"tid\":" << thread->thread;
+				if (event.depth < 0)									// Counter
+					file << ",\"cat\":\"counter\",\"ph\":\"C\",\"args\":{\"value\":" << event.duration << "}}";
+				else
+					file << ",\"cat\":\"zone\",\"ph\":\"X\",\"dur\":" << event.duration / 1000.0 << ",\"args\":{\"depth\":" << event.depth << "}}";
+			}
+		}
+		file << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+		std::cout << "Dumped profile: " << output << " (Events # = " << zones << ")" << std::endl;
+		return true;
+	}
+};
+// -------------------- Namespace: Profiler --------------------
\ No newline at end of file
@@ -0,0 +1,54 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+# ifndef __PROFILER__
+# define __PROFILER__
+
+# include <string>
+
+// -------------------- Namespace: Profiler --------------------
+namespace Profiler {													// Named zones & counters of every thread - only uses the standard library, so the simulation can be profiled headless
+	void Init();														// Initialize Profiler Library (called by Utilities::Init)
+	void Exit();														// Clean up Profiler Library
+
+	void Begin(const char* zone);										// Open a named zone on the calling thread (use string literals - name is kept by pointer)
+	void End();															// Close the last opened zone of the calling thread
+	void Counter(const char* counter, long long value);					// Record the value of a named counter at this moment (shown as a graph)
+
+	void SetOutput(std::string file);									// Set file where the recorded zones are written (by default profile.json)
+	bool Dump();														// Write the recorded zones of all threads as Chrome trace_event JSON (open with chrome://tracing)
+
+	class Zone {														// Scoped zone - opened when constructed, closed when destroyed
+	public:
+		Zone(const char* zone) { Begin(zone); }
+		~Zone() { End(); }
+	};
+};
+
+# define PROFILE_ZONE_NAME(line) profilerZone##line
+# define PROFILE_ZONE_LINE(zone, line) Profiler::Zone PROFILE_ZONE_NAME(line)(zone)
+# define PROFILE_ZONE(zone) PROFILE_ZONE_LINE(zone, __LINE__)			// Profile the rest of the enclosing scope as a named zone
+// -------------------- Namespace: Profiler --------------------
+
+# endif  // # ifndef __PROFILER__
\ No newline at end of file
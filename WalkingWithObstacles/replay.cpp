@@ -0,0 +1,178 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <algorithm>
+# include <fstream>
+# include <iostream>
+# include <iterator>
+# include <vector>
+
+# include "replay.h"
+# include "varint.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// File: "WWOR", version, seed & runner - then every tick: (length << 1 | has keys) [, number of keys, (type, key) per key]
+// Numbers are stored as varints - most ticks take a single byte
+static const char magic[4] = { 'W', 'W', 'O', 'R' };
+static const unsigned char version = 1;
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Namespace: Replay --------------------
+namespace Replay {
+	static std::string output;											// File recorded into (empty: not recording)
+	static bool replaying = false;
+	static std::vector <unsigned char> data;							// Recording being written or replayed
+	static unsigned cursor = 0;											// Next byte of the replay
+	static unsigned start = 0;											// First tick of the replay
+	static unsigned seed = 0;
+	static int character = 0;
+	static std::vector <int> keys;										// (type, key) pairs - logged for the next tick or read from the current one
+	static unsigned next = 0;											// Next key of the current tick (replay)
+	static bool walking = false;										// A walk is being recorded
+
+	void Record(std::string file) {
+		output = file;
+		replaying = false;
+	}
+
+	bool Load(std::string file) {
+		std::ifstream input(file, std::ios::binary);
+		if (!input.is_open()) {
+			std::cerr << "Cannot read replay: " << file << std::endl;
+			return false;
+		}
+		data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+		cursor = sizeof(magic) + 1;
+		unsigned value = 0;
+		if (data.size() < cursor || !std::equal(magic, magic + sizeof(magic), data.begin()) || data[sizeof(magic)] != version
+			|| !Varint::Read(data, cursor, seed) || !Varint::Read(data, cursor, value)) {
+			std::cerr << "Not a replay: " << file << std::endl;
+			data.clear();
+			return false;
+		}
+		character = (int)value;
+		start = cursor;
+		replaying = true;
+		output.clear();
+		std::cout << "Loaded replay: " << file << " (" << data.size() << " bytes)" << std::endl;
+		return true;
+	}
+
+	bool IsRecording() {
+		return !output.empty();
+	}
+
+	bool IsReplaying() {
+		return replaying;
+	}
+
+	unsigned GetSeed() {
+		return seed;
+	}
+
+	int GetCharacter() {
+		return character;
+	}
+
+	void Begin(unsigned seed, int character) {
+		keys.clear();
+		next = 0;
+		if (replaying) {
+			cursor = start;
+			return;
+		}
+		if (!IsRecording())
+			return;
+		data.assign(magic, magic + sizeof(magic));
+		data.push_back(version);
+		Varint::Write(data, seed);
+		Varint::Write(data, (unsigned)character);
+		walking = true;
+	}
+
+	void Event(int type, int key) {
+		if (walking) {
+			keys.push_back(type);
+			keys.push_back(key);
+		}
+	}
+
+	bool Tick(int& elapsedTime) {
+		if (walking) {
+			unsigned length = elapsedTime > 0 ? (unsigned)elapsedTime : 0;
+			Varint::Write(data, length << 1 | (keys.empty() ? 0 : 1));
+			if (!keys.empty()) {
+				Varint::Write(data, (unsigned)keys.size() / 2);
+				for (unsigned i = 0; i < keys.size(); i += 2) {
+					data.push_back((unsigned char)keys[i]);
+					Varint::Write(data, (unsigned)keys[i + 1]);
+				}
+				keys.clear();
+			}
+			return true;
+		}
+		if (!replaying)
+			return true;
+		keys.clear();
+		next = 0;
+		unsigned value = 0, count = 0, key = 0;
+		if (!Varint::Read(data, cursor, value))
+			return false;
+		elapsedTime = (int)(value >> 1);
+		if ((value & 1) && Varint::Read(data, cursor, count))
+			for (unsigned i = 0; i < count && cursor < data.size(); i++) {
+				int type = data[cursor++];
+				if (!Varint::Read(data, cursor, key))
+					break;
+				keys.push_back(type);
+				keys.push_back((int)key);
+			}
+		return true;
+	}
+
+	bool Next(int& type, int& key) {
+		if (!replaying || next >= keys.size())
+			return false;
+		type = keys[next++];
+		key = keys[next++];
+		return true;
+	}
+
+	void End() {
+		if (!walking)
+			return;
+		walking = false;
+		std::ofstream file(output, std::ios::binary);
+		if (!file.is_open()) {
+			std::cerr << "Cannot write replay: " << output << std::endl;
+			return;
+		}
+		file.write((const char*)&data[0], data.size());
+		std::cout << "Recorded replay: " << output << " (" << data.size() << " bytes)" << std::endl;
+	}
+};
+// -------------------- Namespace: Replay --------------------
\ No newline at end of file
@@ -0,0 +1,50 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __REPLAY__
+# define __REPLAY__
+
+# include <string>
+
+// -------------------- Namespace: Replay --------------------
+namespace Replay {														// Keys of a walk logged per simulation tick - replayed at the same ticks, with the same tick lengths & course
+	enum Events { KEYBOARD, SPECIAL_KEYBOARD };
+
+	void Record(std::string file);										// Record the walks into file (--record - each walk started overwrites it)
+	bool Load(std::string file);										// Replay the walk recorded in file (--replay) - false if it can't be read
+	bool IsRecording();
+	bool IsReplaying();
+	unsigned GetSeed();													// Seed of the course of the loaded walk
+	int GetCharacter();													// Runner of the loaded walk
+
+	void Begin(unsigned seed, int character);							// A walk starts - recording restarts, replay rewinds
+	void Event(int type, int key);										// Log a key pressed (when recording) - it belongs to the next tick
+	bool Tick(int& elapsedTime);										// Start a tick - its length is logged (recording) or replaced with the recorded one (replay) - false: replay is over
+	bool Next(int& type, int& key);										// Next recorded key of the current tick - false if none left
+	void End();															// The walk is over - the recording is written
+};
+// -------------------- Namespace: Replay --------------------
+
+# endif  // # ifndef __REPLAY__
\ No newline at end of file
@@ -0,0 +1,237 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include <cfloat>
+
+# include "simulation.h"
+
+// -------------------- Class: PoseClip --------------------
+PoseClip::PoseClip(const float* phases, const float* values, int keys) {
+	int key = 0;
+	for (int i = 0; i <= SAMPLES; i++) {
+		float phase = (float)i / SAMPLES;
+		while (key < keys - 2 && phase > phases[key + 1])
+			key++;
+		float t = (phase - phases[key]) / (phases[key + 1] - phases[key]);
+		table[i] = values[key] + (values[key + 1] - values[key]) * t;
+	}
+}
+// -------------------- Class: PoseClip --------------------
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// Run cycle: arms/legs swing from -amplitude to amplitude & back (amplitude: 45 + speed) - the low parts bend while they swing back
+// Keyframes of a runner at speed 15 - rotationH is a fraction of the amplitude, so it follows the speed
+static const float runPhases[] = { 0.0f, 0.1875f, 0.5f, 0.6875f, 1.0f };
+static const float runSwings[] = { -1.0f, -0.25f, 1.0f, 0.25f, -1.0f };
+static const float runBends[] = { 45.0f, 0.0f, 0.0f, 45.0f, 45.0f };
+static const float jumpPhases[] = { 0.0f, 0.5f, 1.0f };
+static const float jumpHeights[] = { 0.0f, 1.0f, 0.0f };
+
+static const PoseClip runSwingClip(runPhases, runSwings, 5);
+static const PoseClip runBendClip(runPhases, runBends, 5);
+static const PoseClip jumpClip(jumpPhases, jumpHeights, 3);
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Class: Motion --------------------
+const float Motion::SPEED_CHANGE = 2.0f, Motion::MIN_SPEED = 8.0f, Motion::MAX_SPEED = 25.0f;
+
+Motion::Motion() : speed(15.0), phase(0.25f), jumping(-1.0f), jumpHeight(0.0), height(0.0), rotationH(0.0), rotationL(0.0) {	// Arms/legs straight, swinging forward
+	pose();
+}
+
+Motion::Motion(float speed, float height, float rotationH, float rotationL) : speed(speed), phase(0.0f), jumping(-1.0f), jumpHeight(0.0),
+height(height), rotationH(rotationH), rotationL(rotationL) {
+}
+
+int Motion::step(int tick) {
+	int events = 0;
+	float advance = Advance(speed, tick);
+	if (jumping >= 0.0f) {
+		phase += advance / 4.0f;										// Arms/legs swing slower in the air
+		jumping += tick / JumpLength(speed);							// Speed doesn't change in the air
+		if (jumping >= 1.0f) {											// Landed during the tick - the time left is spent running
+			phase += 0.75f * Advance(speed, (jumping - 1.0f) * JumpLength(speed));
+			jumping = -1.0f;
+			events |= Simulation::LAND;
+		}
+	}
+	else {
+		if ((int)(2.0f * phase) != (int)(2.0f * (phase + advance)))	// Passed the middle or the end of the cycle - a foot hits the ground
+			events |= Simulation::STEP;
+		phase += advance;
+	}
+	phase -= (int)phase;
+	pose();
+	return events;
+}
+
+void Motion::speedUp() {												// Increase runners speed
+	if (jumping < 0.0f) {
+		speed += SPEED_CHANGE;
+		if (speed > MAX_SPEED)
+			speed = MAX_SPEED;
+	}
+}
+
+void Motion::slowDown() {												// Decrease runners speed
+	if (jumping < 0.0f) {
+		speed -= SPEED_CHANGE;
+		if (speed < MIN_SPEED)
+			speed = MIN_SPEED;
+	}
+}
+
+void Motion::jump() {													// Makes runner jump
+	if (jumping < 0.0f) {
+		jumping = 0.0f;
+		jumpHeight = JumpHeight(speed);
+	}
+}
+
+float Motion::Advance(float speed, float tick) {
+	return speed * tick / 35.0f / (4.0f * (45.0f + speed));				// Arms/legs swing speed / 35 degrees per millisecond
+}
+
+float Motion::Distance(float speed, float tick) {
+	return speed * tick / 80.0f;										// speed / 5 per tick of 16 milliseconds
+}
+
+float Motion::JumpHeight(float speed) {
+	return 5.0f * speed < 80.0f ? 5.0f * speed : 80.0f;
+}
+
+float Motion::JumpLength(float speed) {
+	return 2.0f * JumpHeight(speed) / (speed / 140.0f);					// Rises & falls at speed / 140 per millisecond
+}
+
+void Motion::Sample(float speed, float phase, float& rotationH, float& rotationL) {
+	rotationH = (45.0f + speed) * runSwingClip.sample(phase);
+	rotationL = runBendClip.sample(phase);
+}
+
+float Motion::SampleJump(float progress) {
+	return jumpClip.sample(progress);
+}
+
+void Motion::pose() {
+	Sample(speed, phase, rotationH, rotationL);
+	height = jumping >= 0.0f ? jumpHeight * SampleJump(jumping) : 0.0f;
+}
+// -------------------- Class: Motion --------------------
+
+// -------------------- Class: Simulation --------------------
+const float Simulation::RANGE = 3000.0f;
+
+Simulation::Simulation(unsigned seed) : course(NULL), seed(seed), index(0), withScenery(false),
+traveled(RANGE), loaded(0.0), ticks(0), hits(0), elapsedTime(0), hit(false), noHit(true) {	// Start of the course is just out of range behind the runner
+	stream();
+}
+
+Simulation::Simulation(Course* course) : course(course), seed(course->getSeed()), index(0), withScenery(true),
+traveled(RANGE), loaded(0.0), ticks(0), hits(0), elapsedTime(0), hit(false), noHit(true) {
+	stream();
+}
+
+void Simulation::reset(unsigned seed) {
+	runner = Motion();
+	scenery.clear();
+	obstacles.clear();
+	course = NULL;
+	this->seed = seed;
+	index = 0;
+	withScenery = false;
+	traveled = RANGE;
+	loaded = 0.0;
+	ticks = 0;
+	hits = 0;
+	elapsedTime = 0;
+	hit = false;
+	noHit = true;
+	stream();
+}
+
+int Simulation::step(int inputs, int tick) {
+	ticks++;
+	if (inputs & JUMP)
+		runner.jump();
+	if (hit) {															// Penalty - runner stands still
+		elapsedTime += tick;
+		if (elapsedTime >= 3000) {
+			hit = false;
+			noHit = true;
+			elapsedTime = 0;
+		}
+		return 0;
+	}
+	if (inputs & SPEED_UP)
+		runner.speedUp();
+	if (inputs & SLOW_DOWN)
+		runner.slowDown();
+	if (noHit) {
+		elapsedTime += tick;
+		if (elapsedTime >= 2000) {
+			noHit = false;
+			elapsedTime = 0;
+		}
+	}
+	float height = runner.getHeight();									// Height before this tick - the hit test sweeps from it to the new one
+	int events = runner.step(tick);
+	float distance = Motion::Distance(runner.getSpeed(), tick);			// Content moves towards the runner
+	traveled += distance;
+	if (withScenery)
+		scenery.scroll(distance, -FLT_MAX, 5.0f);						// Nothing wraps - stream releases what is left behind
+	obstacles.scroll(distance);
+	stream();
+	if (obstacles.findImpact(distance, 5.0f, height, runner.getHeight(), 30.0f) >= 0.0f && !noHit) {	// Only the next obstacle is checked
+		hit = true;
+		hits++;
+		events |= HIT;
+	}
+	return events;
+}
+
+void Simulation::stream() {
+	while (loaded - traveled < RANGE) {									// Until the range is covered
+		Chunk* next = &chunk;
+		if (course != NULL)
+			next = course->next();
+		else
+			Course::Generate(seed, index++, chunk);
+		float start = (float)(next->start - traveled);
+		if (withScenery)
+			for (unsigned i = 0; i < next->sceneryX.size(); i++)		// Render handle of the entity is the kind of scenery
+				scenery.add(EntityStore::SCENERY, start + next->sceneryX[i], next->sceneryKinds[i] == Chunk::TREE ? -10.0f : 25.0f, next->sceneryZ[i], next->sceneryKinds[i]);
+		for (unsigned i = 0; i < next->obstacles.size(); i++)
+			obstacles.push(start + next->obstacles[i], 25.0f, -50.0f);
+		loaded = next->start + Course::LENGTH;
+		if (course != NULL)
+			course->recycle(next);
+	}
+	scenery.release(-RANGE);
+	obstacles.release(-RANGE);
+}
+// -------------------- Class: Simulation --------------------
\ No newline at end of file
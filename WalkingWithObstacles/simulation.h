@@ -0,0 +1,134 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __SIMULATION__
+# define __SIMULATION__
+
+# include "course.h"
+# include "entities.h"
+
+// -------------------- Class: PoseClip --------------------
+class PoseClip {														// Keyframed value over a normalized phase [0, 1] - sampled from a table precomputed once
+public:
+	PoseClip(const float* phases, const float* values, int keys);		// Keyframes ordered by phase (the first at 0, the last at 1) - linear between them
+
+	float sample(float phase) const {
+		float position = phase * SAMPLES;
+		int i = (int)position;
+		if (i >= SAMPLES)
+			return table[SAMPLES];
+		return table[i] + (table[i + 1] - table[i]) * (position - i);
+	}
+
+	static const int SAMPLES = 64;
+
+private:
+	float table[SAMPLES + 1];
+};
+// -------------------- Class: PoseClip --------------------
+
+// -------------------- Class: Motion --------------------
+class Motion {															// Movement of a runner - speed, jumps & the swing of its arms/legs (no rendering or audio)
+public:
+	Motion();
+	Motion(float speed, float height, float rotationH, float rotationL);	// Pose of a recorded runner (to be displayed - it isn't stepped)
+
+	int step(int tick);													// Advance by a tick (in milliseconds) - returns the events of the tick (see Simulation::Events)
+
+	void speedUp();
+	void slowDown();
+	void jump();
+
+	float getSpeed() const { return speed; }
+	float getHeight() const { return height; }							// Distance from ground (when jumping-falling)
+	float getRotationH() const { return rotationH; }					// Rotation for high & low part of hands & legs
+	float getRotationL() const { return rotationL; }
+
+	static const float SPEED_CHANGE, MIN_SPEED, MAX_SPEED;				// Value of speed change each time user speeds up/slows down, and minimum/maximum speed
+
+	static float Advance(float speed, float tick);						// Phase of the run cycle covered in a tick
+	static float Distance(float speed, float tick);						// Distance covered in a tick
+	static float JumpHeight(float speed);								// Top of a jump started at speed
+	static float JumpLength(float speed);								// Time in the air of a jump started at speed (in milliseconds)
+	static void Sample(float speed, float phase, float& rotationH, float& rotationL);	// Swing of the arms/legs at a phase of the run cycle
+	static float SampleJump(float progress);							// Height at a point of a jump [0, 1) - as a fraction of the top
+
+private:
+	void pose();														// Sample the pose of the current phase & jump
+
+	float speed;														// Runners current moving speed
+	float phase;														// Run cycle: [0, 0.5) right arm front, [0.5, 1) left arm front
+	float jumping;														// Progress of the current jump [0, 1) (-1: on the ground)
+	float jumpHeight;													// How high runner jumps, depends on the speed at that time
+	float height;
+	float rotationH, rotationL;
+};
+// -------------------- Class: Motion --------------------
+
+// -------------------- Class: Simulation --------------------
+class Simulation {														// Rules of a walk - the same seed & inputs always give the same walk (no rendering, audio or clock)
+public:
+	Simulation(unsigned seed);											// Headless walk - chunks are generated on the calling thread & scenery is left out
+	Simulation(Course* course);											// Walk over the chunks of a course (generated ahead by its worker) - with scenery, to be displayed
+
+	enum Inputs { SPEED_UP = 1, SLOW_DOWN = 2, JUMP = 4 };				// Keys pressed during a tick (bits)
+	enum Events { STEP = 1, LAND = 2, HIT = 4 };						// What happened during a tick (bits) - sounds & messages are left to the caller
+
+	void reset(unsigned seed);											// Start a new headless walk over the course of seed (buffers are reused)
+	int step(int inputs, int tick);										// Advance the walk by a tick (in milliseconds) - returns its events
+
+	const Motion& getRunner() const { return runner; }
+	const EntityStore& getScenery() const { return scenery; }
+	const ObstacleRing& getObstacles() const { return obstacles; }
+	double getTraveled() const { return traveled; }						// Distance from the start of the course
+	long long getTicks() const { return ticks; }
+	int getHits() const { return hits; }
+	bool isHit() const { return hit; }									// Runner has hit an obstacle - it stands still until the penalty is over
+	bool isProtected() const { return noHit; }							// Hits are ignored (at the start & after a penalty)
+
+	static const float RANGE;											// Content is kept within [-RANGE, RANGE] of the runner
+
+private:
+	void stream();														// Add the chunks of the course coming into range - release the content left behind
+
+	Motion runner;
+	EntityStore scenery;
+	ObstacleRing obstacles;												// Ordered by position
+	Course* course;														// NULL: chunks are generated on the calling thread
+	Chunk chunk;														// Chunk generated on the calling thread (its buffers are reused)
+	unsigned seed;
+	int index;															// Next chunk generated on the calling thread
+	bool withScenery;
+	double traveled;
+	double loaded;														// Distance up to which the course has been added to the content
+	long long ticks;
+	int hits;
+	int elapsedTime;													// Time in the current penalty or protection (in milliseconds)
+	bool hit;
+	bool noHit;
+};
+// -------------------- Class: Simulation --------------------
+
+# endif  // # ifndef __SIMULATION__
\ No newline at end of file
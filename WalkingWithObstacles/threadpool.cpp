@@ -0,0 +1,211 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# include "threadpool.h"
+
+// -------------------- Static content - to be used only in this file -------------------
+
+static thread_local ThreadPool* owner = NULL;							// Pool of the calling worker thread (NULL if it isn't a worker)
+static thread_local int current = -1;									// Index of the calling worker in its pool
+
+// -------------------- Static content - to be used only in this file -------------------
+
+// -------------------- Class: ThreadPool --------------------
+ThreadPool::ThreadPool(int threads) : next(0), queued(0), pending(0), stop(false), reset(std::chrono::steady_clock::now()) {
+	if (threads <= 0)
+		threads = (int)std::thread::hardware_concurrency();
+	if (threads <= 0)													// Unknown
+		threads = 1;
+	for (int i = 0; i < threads; i++) {
+		workers.push_back(new Worker());
+		workers[i]->executed = 0;
+		workers[i]->steals = 0;
+		workers[i]->busy = 0;
+	}
+	for (int i = 0; i < threads; i++)									// Started once every deque exists - workers steal from each other
+		workers[i]->thread = std::thread(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+	wait();
+	{
+		std::lock_guard <std::mutex> lock(mutex);
+		stop = true;
+	}
+	wake.notify_all();
+	for (unsigned i = 0; i < workers.size(); i++) {
+		workers[i]->thread.join();
+		delete workers[i];
+	}
+}
+
+void ThreadPool::submit(std::function<void()> task, Counter* counter) {
+	int index = owner == this ? current : (int)(next++ % workers.size());
+	if (counter != NULL)
+		counter->count.fetch_add(1, std::memory_order_relaxed);			// Before the task can finish
+	{
+		std::lock_guard <std::mutex> lock(mutex);						// Before the task can be taken - wait() would return while it runs otherwise
+		queued++;
+		pending++;
+	}
+	{
+		std::lock_guard <std::mutex> lock(workers[index]->mutex);
+		Task queuedTask = { task, counter };
+		workers[index]->tasks.push_back(queuedTask);
+	}
+	wake.notify_one();
+}
+
+void ThreadPool::wait() {
+	std::unique_lock <std::mutex> lock(mutex);
+	done.wait(lock, [this] { return pending == 0; });
+}
+
+void ThreadPool::wait(Counter& counter) {
+	int index = owner == this ? current : -1;
+	Task task;
+	bool stolen;
+	while (take(index, task, stolen, &counter))							// Help with the tasks waited on - they may be queued behind others (e.g. long decodes)
+		execute(task);
+	std::unique_lock <std::mutex> lock(mutex);							// The rest were taken by the workers - they are finishing them
+	finished.wait(lock, [&counter] { return counter.isDone(); });
+}
+
+void ThreadPool::parallelFor(int first, int last, int grain, std::function<void(int first, int last)> body) {
+	if (grain < 1)
+		grain = 1;
+	if (last - first <= grain) {										// A single range - nothing to share
+		if (first < last)
+			body(first, last);
+		return;
+	}
+	Counter counter;
+	for (int begin = first + grain; begin < last; begin += grain) {
+		int end = begin + grain < last ? begin + grain : last;
+		submit([&body, begin, end] { body(begin, end); }, &counter);	// body outlives its tasks - they are waited on below
+	}
+	body(first, first + grain);
+	wait(counter);
+}
+
+int ThreadPool::getThreads() const {
+	return (int)workers.size();
+}
+
+ThreadPool::Stats ThreadPool::getStats(int worker) const {
+	Stats stats;
+	stats.tasks = workers[worker]->executed.load(std::memory_order_relaxed);
+	stats.steals = workers[worker]->steals.load(std::memory_order_relaxed);
+	stats.busy = workers[worker]->busy.load(std::memory_order_relaxed) / 1000000.0;
+	return stats;
+}
+
+double ThreadPool::getUtilization() const {
+	double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - reset).count();
+	if (elapsed <= 0.0)
+		return 0.0;
+	double busy = 0.0;
+	for (unsigned i = 0; i < workers.size(); i++)
+		busy += getStats(i).busy;
+	busy /= elapsed * workers.size();
+	return busy < 1.0 ? busy : 1.0;										// A task running when the statistics were reset counts whole
+}
+
+void ThreadPool::resetStats() {
+	for (unsigned i = 0; i < workers.size(); i++) {
+		workers[i]->executed = 0;
+		workers[i]->steals = 0;
+		workers[i]->busy = 0;
+	}
+	reset = std::chrono::steady_clock::now();
+}
+
+ThreadPool& ThreadPool::Shared() {
+	static ThreadPool* shared = new ThreadPool(std::thread::hardware_concurrency() > 1 ? (int)std::thread::hardware_concurrency() - 1 : 1);	// Never destroyed - its workers may be decoding while the application exits
+	return *shared;
+}
+
+void ThreadPool::work(int index) {
+	owner = this;
+	current = index;
+	Worker* worker = workers[index];
+	Task task;
+	bool stolen;
+	while (true) {
+		{
+			std::unique_lock <std::mutex> lock(mutex);
+			wake.wait(lock, [this] { return stop || queued > 0; });
+			if (stop)
+				return;
+		}
+		if (!take(index, task, stolen))									// Another worker got it first
+			continue;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		execute(task);
+		worker->busy += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		worker->executed++;
+		if (stolen)
+			worker->steals++;
+	}
+}
+
+bool ThreadPool::take(int index, Task& task, bool& stolen, const Counter* counter) {
+	int first = index < 0 ? 0 : index;
+	for (unsigned i = 0; i < workers.size(); i++) {						// Own deque first, then the others in turn
+		Worker* worker = workers[(first + i) % workers.size()];
+		std::lock_guard <std::mutex> lock(worker->mutex);
+		if (worker->tasks.empty())
+			continue;
+		stolen = index < 0 || i > 0;
+		std::deque <Task>::iterator it;
+		if (counter != NULL) {											// The first queued of counter
+			it = worker->tasks.begin();
+			while (it != worker->tasks.end() && it->counter != counter)
+				it++;
+			if (it == worker->tasks.end())
+				continue;
+		}
+		else
+			it = stolen ? worker->tasks.begin() : worker->tasks.end() - 1;
+		task = *it;
+		worker->tasks.erase(it);
+		std::lock_guard <std::mutex> lockQueued(mutex);
+		queued--;
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::execute(Task& task) {
+	task.function();
+	task.function = std::function<void()>();							// Release what it captured before the task is counted as finished
+	bool last = task.counter != NULL && task.counter->count.fetch_sub(1, std::memory_order_release) == 1;	// The counter may be gone once it is done
+	std::lock_guard <std::mutex> lock(mutex);
+	if (--pending == 0)
+		done.notify_all();
+	if (last)
+		finished.notify_all();
+}
+// -------------------- Class: ThreadPool --------------------
\ No newline at end of file
@@ -0,0 +1,119 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __THREADPOOL__
+# define __THREADPOOL__
+
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <deque>
+# include <functional>
+# include <future>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <type_traits>
+# include <vector>
+
+// -------------------- Class: ThreadPool --------------------
+class ThreadPool {														// Worker threads running tasks - each worker has a deque of its own & steals from the others when it runs out
+public:
+	ThreadPool(int threads = 0);										// 0: one worker per hardware thread
+	~ThreadPool();														// Waits for the queued tasks
+
+	class Counter {														// Tasks of a job that haven't finished - a job is waited on by its counter instead of the whole pool
+	public:
+		Counter() : count(0) {}
+		bool isDone() const { return count.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class ThreadPool;
+		std::atomic<int> count;
+	};
+
+	class Stats {														// Work of a worker since the statistics were reset
+	public:
+		long long tasks;
+		long long steals;												// Tasks taken from the deque of another worker
+		double busy;													// Time spent running tasks (in milliseconds)
+	};
+
+	void submit(std::function<void()> task, Counter* counter = NULL);	// Queue a task - to the calling worker's deque, or round robin from other threads (counted by counter if given)
+	void wait();														// Wait until every submitted task has finished (not to be called by a task)
+	void wait(Counter& counter);										// Run the queued tasks of counter on the calling thread & sleep until the others have finished (can be called by a task)
+	void parallelFor(int first, int last, int grain, std::function<void(int first, int last)> body);	// Run body over ranges of [first, last) of grain items - the calling thread runs one of them & waits for the rest
+
+	template <class F>
+	std::future<typename std::result_of<F()>::type> async(F function) {	// Queue a task returning a value - to be taken from the future (e.g. an asset decoded in the background)
+		typedef typename std::result_of<F()>::type T;
+		std::shared_ptr<std::packaged_task<T()> > task = std::make_shared<std::packaged_task<T()> >(function);
+		submit([task] { (*task)(); });
+		return task->get_future();
+	}
+
+	int getThreads() const;
+	Stats getStats(int worker) const;
+	double getUtilization() const;										// Fraction of the time since the statistics were reset that the workers spent running tasks [0, 1]
+	void resetStats();
+
+	static ThreadPool& Shared();										// Pool of the application - created when first used with a worker per hardware thread but one (the main thread is busy too)
+
+private:
+	class Task {
+	public:
+		std::function<void()> function;
+		Counter* counter;												// NULL: not counted
+	};
+
+	class Worker {
+	public:
+		std::deque <Task> tasks;										// Owner takes from the back (last queued), thieves from the front
+		std::mutex mutex;
+		std::thread thread;
+		std::atomic<long long> executed, steals, busy;					// Statistics (busy in nanoseconds)
+	};
+
+	void work(int index);												// Loop of a worker thread
+	bool take(int index, Task& task, bool& stolen, const Counter* counter = NULL);	// Own task or one stolen from another worker (index -1: the calling thread isn't a worker) - only of counter if given
+	void execute(Task& task);											// Run a task & count it as finished
+
+	std::vector <Worker*> workers;
+	std::atomic<unsigned> next;											// Worker given the next task from outside the pool
+	int queued;															// Tasks waiting in the deques (guarded by mutex)
+	int pending;														// Tasks submitted but not finished (guarded by mutex)
+	bool stop;
+	std::mutex mutex;
+	std::condition_variable wake;										// Signals a queued task or stop
+	std::condition_variable done;										// Signals that all tasks have finished
+	std::condition_variable finished;									// Signals that the tasks of a counter have finished
+	std::chrono::steady_clock::time_point reset;						// When the statistics were reset
+
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+};
+// -------------------- Class: ThreadPool --------------------
+
+# endif  // # ifndef __THREADPOOL__
\ No newline at end of file
@@ -26,11 +26,21 @@
 # include <iostream>
 # include <queue>
 # include <fstream>
+# include <map>
+# include <atomic>
+# include <chrono>
+# include <future>
+# include <thread>
+# include <cfloat>
 
 # include "gl\glut.h"
 # include "fmod\fmod.hpp"
 # include "corona\corona.h"
 
+# include "utilities.h"
+# include "threadpool.h"
+# include "glstatistics.h"
+
 // -------------------- Static functions - to be used only in this file -------------------
 static void Planar_Mapping(float size, float x, float y, float z, float v1[3], float v2[3]) {
 	float u, t;
@@ -119,6 +129,7 @@ namespace Audio {
 		FMOD::Sound* sound;
 		FMOD::Channel* channel;
 		double volume;
+		int references;													// Loads not matched by an Unload yet
 	};
 
 	static bool freeChannels[MAX_CHANNELS];
@@ -162,6 +173,7 @@ namespace Audio {
 	}
 
 	static void Update() {												// Update Audio Library
+		PROFILE_ZONE("Audio::Update");
 		system->update();
 	}
 
@@ -175,9 +187,13 @@ namespace Audio {
 		std::cout << "Cleaned Audio Library.." << std::endl;
 	}
 
-	void Load(std::string _audio) {										// Load audio file into memory
-		if (sounds.find(_audio) != sounds.end())						// If sound already exists in hash map
-			return;														// Don't delay reading it from file
+	static void Wait(FMOD::Sound* sound) {								// Wait until a preloaded sound has been read
+		FMOD_OPENSTATE state = FMOD_OPENSTATE_LOADING;
+		while (sound->getOpenState(&state, 0, 0, 0) == FMOD_OK && state != FMOD_OPENSTATE_READY && state != FMOD_OPENSTATE_ERROR)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	static void Open(std::string _audio, FMOD_MODE mode) {				// Create sound from audio file & give it a channel
 		std::string audio = "sounds\\" + _audio + ".ogg";
 		Sound sound;
 		int i;
@@ -187,18 +203,48 @@ namespace Audio {
 				break;
 			}
 		sound.volume = 1.0;
-		if (system->createSound(audio.c_str(), FMOD_HARDWARE, 0, &(sound.sound)) != FMOD_OK)
+		sound.references = 1;
+		if (system->createSound(audio.c_str(), FMOD_HARDWARE | mode, 0, &(sound.sound)) != FMOD_OK)
 			std::cout << "Missing audio: " << _audio << ".ogg" << std::endl;
 		else {
-			std::cout << "Loaded audio: " << _audio << ".ogg" << std::endl;
+			std::cout << (mode & FMOD_NONBLOCKING ? "Preloading audio: " : "Loaded audio: ") << _audio << ".ogg" << std::endl;
 			system->getChannel(i, &sound.channel);
 			sounds[_audio] = sound;										// Insert new sound in hash map if it doesn't exist already
 		}
 	}
 
+	void Load(std::string audio) {										// Load audio file into memory
+		std::unordered_map <std::string, Sound>::iterator it = sounds.find(audio);	// Find sound in hash map
+		if (it != sounds.end()) {										// If sound already exists in hash map
+			it->second.references++;									// Don't delay reading it from file
+			Wait(it->second.sound);										// Unless it is still being preloaded
+			return;
+		}
+		Open(audio, 0);
+	}
+
+	void Preload(std::string audio) {									// Start loading audio file in the background
+		std::unordered_map <std::string, Sound>::iterator it = sounds.find(audio);	// Find sound in hash map
+		if (it != sounds.end()) {										// If sound already exists in hash map
+			it->second.references++;
+			return;
+		}
+		Open(audio, FMOD_NONBLOCKING);									// FMOD reads the file on its own thread
+	}
+
+	bool IsLoading(std::string audio) {									// Check if preloaded audio file is still being read
+		std::unordered_map <std::string, Sound>::iterator it = sounds.find(audio);	// Find sound in hash map
+		FMOD_OPENSTATE state = FMOD_OPENSTATE_READY;
+		if (it != sounds.end())											// If sound exists in hash map
+			it->second.sound->getOpenState(&state, 0, 0, 0);
+		return state != FMOD_OPENSTATE_READY && state != FMOD_OPENSTATE_ERROR;
+	}
+
 	void Unload(std::string audio) {									// Unload audio file from memory
 		std::unordered_map <std::string, Sound>::iterator it = sounds.find(audio);	// Find sound in hash map
 		if (it != sounds.end()) {										// If sound exists in hash map
+			if (--it->second.references > 0)							// Still loaded by someone else
+				return;
 			it->second.sound->release();
 			sounds.erase(audio);										// Erase sound from hash map
 			std::cout << "Unloaded audio: " << audio << ".ogg" << std::endl;
@@ -277,12 +323,27 @@ namespace Audio {
 		for (it = sounds.begin(); it != sounds.end(); it++)
 			it->second.channel->setPaused(false);
 	}
+
+	int GetMemoryUsage() {												// Get memory currently allocated by FMOD (in bytes)
+		int current = 0, max = 0;
+		FMOD::Memory_GetStats(&current, &max, false);
+		return current;
+	}
 };
 // -------------------- Namespace: Audio --------------------
 
 // -------------------- Namespace: Texture --------------------
 namespace Texture {
-	static std::unordered_map <std::string, GLuint> textures;			// Hash map with all loaded textures
+	class Image {
+	public:
+		GLuint texture;
+		int size;														// Bytes used by the texture & its mipmaps
+		int references;													// Loads not matched by an Unload yet
+	};
+
+	static std::unordered_map <std::string, Image> textures;			// Hash map with all loaded textures
+	static std::unordered_map <std::string, std::future<corona::Image*> > decoding;	// Preloaded textures not uploaded yet (decoded by other threads)
+	static int memory = 0;												// Bytes used by all loaded textures
 
 	static void Init() {												// Initialize Texture Library
 		glMatrixMode(GL_TEXTURE);
@@ -290,11 +351,55 @@ namespace Texture {
 		std::cout << "Initialized Texture Library.." << std::endl;
 	}
 
+	static corona::Image* Decode(std::string texture) {					// Read texture file into memory (called by any thread - no OpenGL calls)
+		std::string file = "textures\\" + texture + ".jpg";
+		return corona::OpenImage(file.c_str(), corona::PF_B8G8R8);
+	}
+
+	static void Upload(std::string texture, corona::Image* image) {		// Create the OpenGL texture of a decoded texture file
+		if (image == NULL) {
+			std::cerr << "Missing texture: " << texture << ".jpg" << std::endl;
+			textures.erase(texture);
+			return;
+		}
+		Image& newTexture = textures[texture];
+		glGenTextures(1, &newTexture.texture);
+		glBindTexture(GL_TEXTURE_2D, newTexture.texture);
+		// Define what happens if given (s,t) outside [0,1] {REPEAT, CLAMP}
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		gluBuild2DMipmaps(GL_TEXTURE_2D, 3, image->getWidth(), image->getHeight(), GL_BGR_EXT, GL_UNSIGNED_BYTE, image->getPixels());
+		newTexture.size = image->getWidth() * image->getHeight() * 3 * 4 / 3;	// Mipmaps add another third
+		memory += newTexture.size;
+		delete image;
+		std::cout << "Loaded texture: " << texture << ".jpg" << std::endl;
+	}
+
+	static void Update() {												// Upload one preloaded texture that has been decoded - uploads are spread over the frames
+		PROFILE_ZONE("Texture::Update");
+		std::unordered_map <std::string, std::future<corona::Image*> >::iterator it;
+		for (it = decoding.begin(); it != decoding.end(); it++)
+			if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+				std::string texture = it->first;
+				corona::Image* image = it->second.get();
+				decoding.erase(it);
+				Upload(texture, image);
+				return;
+			}
+	}
+
 	static void Exit() {												// Clean up Texture Library
-		std::unordered_map <std::string, GLuint>::iterator it;
+		std::unordered_map <std::string, std::future<corona::Image*> >::iterator itd;
+		for (itd = decoding.begin(); itd != decoding.end(); itd++)
+			delete itd->second.get();									// Wait for the decoding threads
+		decoding.clear();
+		std::unordered_map <std::string, Image>::iterator it;
 		for (it = textures.begin(); it != textures.end(); it++)
-			glDeleteTextures(1, &it->second);
+			glDeleteTextures(1, &it->second.texture);
 		textures.clear();
+		memory = 0;
 		std::cout << "Cleaned Texture Library.." << std::endl;
 	}
 
@@ -306,41 +411,68 @@ namespace Texture {
 		glDisable(GL_TEXTURE_2D);
 	}
 
-	void Load(std::string _texture) {									// Load texture file into memory
-		if (textures.find(_texture) != textures.end())					// If texture already exists in hash map
+	void Load(std::string texture) {									// Load texture file into memory
+		PROFILE_ZONE("Texture::Load");
+		std::unordered_map <std::string, Image>::iterator it = textures.find(texture);	// Find texture in hash map
+		if (it != textures.end()) {										// If texture already exists in hash map
+			it->second.references++;
+			std::unordered_map <std::string, std::future<corona::Image*> >::iterator pending = decoding.find(texture);
+			if (pending != decoding.end()) {							// Preloaded but not uploaded yet - finish it now
+				corona::Image* image = pending->second.get();
+				decoding.erase(pending);
+				Upload(texture, image);
+			}
 			return;
-		std::string texture = "textures\\" + _texture + ".jpg";
-		GLuint newTexture;
-		corona::Image* image = corona::OpenImage(texture.c_str(), corona::PF_B8G8R8);
-		if (image == NULL) {
-			std::cerr << "Missing texture: " << _texture << ".jpg" << std::endl;
+		}
+		Image& newTexture = textures[texture];							// Insert new texture in hash map
+		newTexture.texture = 0;
+		newTexture.size = 0;
+		newTexture.references = 1;
+		Upload(texture, Decode(texture));
+	}
+
+	void Preload(std::string texture) {									// Start loading texture file in the background
+		std::unordered_map <std::string, Image>::iterator it = textures.find(texture);	// Find texture in hash map
+		if (it != textures.end()) {										// If texture already exists in hash map
+			it->second.references++;
 			return;
 		}
-		glGenTextures(1, &newTexture);
-		glBindTexture(GL_TEXTURE_2D, newTexture);
-		// Define what happens if given (s,t) outside [0,1] {REPEAT, CLAMP}
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		gluBuild2DMipmaps(GL_TEXTURE_2D, 3, image->getWidth(), image->getHeight(), GL_BGR_EXT, GL_UNSIGNED_BYTE, image->getPixels());
-		textures[_texture] = newTexture;								// Insert new texture in hash map if it doesn't exist already
-		std::cout << "Loaded texture: " << _texture << ".jpg" << std::endl;
+		Image& newTexture = textures[texture];							// Inserted now - texture is created when the file has been decoded
+		newTexture.texture = 0;
+		newTexture.size = 0;
+		newTexture.references = 1;
+		decoding[texture] = ThreadPool::Shared().async([texture] { return Decode(texture); });	// Decoded by the workers of the application's pool
+	}
+
+	bool IsLoading(std::string texture) {								// Check if preloaded texture hasn't been uploaded yet
+		return decoding.find(texture) != decoding.end();
 	}
 
 	void Unload(std::string texture) {									// Unload texture from memory
-		std::unordered_map <std::string, GLuint>::iterator it = textures.find(texture);	// Find texture in hash map
+		std::unordered_map <std::string, Image>::iterator it = textures.find(texture);	// Find texture in hash map
 		if (it != textures.end()) {										// If texture exists in hash map
-			glDeleteTextures(1, &it->second);
+			if (--it->second.references > 0)							// Still loaded by someone else
+				return;
+			std::unordered_map <std::string, std::future<corona::Image*> >::iterator pending = decoding.find(texture);
+			if (pending != decoding.end()) {							// Preloaded but never uploaded
+				delete pending->second.get();
+				decoding.erase(pending);
+			}
+			glDeleteTextures(1, &it->second.texture);
+			memory -= it->second.size;
 			textures.erase(texture);
 			std::cout << "Unloaded texture: " << texture << ".jpg" << std::endl;
 		}
 	}
 
 	void Use(std::string texture) {										// Applies texture to the next displayed objects
-		std::unordered_map <std::string, GLuint>::iterator it = textures.find(texture);	// Find texture in hash map
+		std::unordered_map <std::string, Image>::iterator it = textures.find(texture);	// Find texture in hash map
 		if (it != textures.end())										// If texture exists in hash map
-			glBindTexture(GL_TEXTURE_2D, it->second);
+			glBindTexture(GL_TEXTURE_2D, it->second.texture);
+	}
+
+	int GetMemoryUsage() {												// Get memory used by the loaded textures (in bytes)
+		return memory;
 	}
 };
 // -------------------- Namespace: Texture --------------------
@@ -349,8 +481,10 @@ namespace Texture {
 namespace Timer {
 	static int startingTime = 0;
 	static int elapsedTime = 0;
+	static std::chrono::high_resolution_clock::time_point epoch;
 
 	static void Init() {												// Initialize Timer for use
+		epoch = std::chrono::high_resolution_clock::now();
 		std::cout << "Initialized Timer Library.." << std::endl;
 	}
 
@@ -369,6 +503,10 @@ namespace Timer {
 	int GetElapsedTime() {												// Get the elapsed time (in milliseconds)
 		return elapsedTime;
 	}
+
+	double GetTime() {													// Get the time since the Timer Library was initialized (in milliseconds - high resolution)
+		return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - epoch).count();
+	}
 };
 // --------------------Namespace: Timer --------------------
 
@@ -382,37 +520,72 @@ namespace Wavefront {
 		Point3D *v, *vn;												// Array of the objects geometric vertices & vertex normals
 		int *vf, *vnf;													// Array of objects faces for geometric vertices & vertex normals
 		int nfaces;														// Number of faces
+		int references;													// Loads not matched by an Unload yet
 	} Object;
 
 	static std::unordered_map <std::string, Object> objects;			// Hash map with all loaded wavefront objects
+	static std::unordered_map <std::string, std::future<Object> > reading;	// Preloaded wavefront objects still being read by other threads
 
 	static void Init() {												// Initialize Wavefront Library
 		objects.clear();
 		std::cout << "Initialized Wavefront Library.." << std::endl;
 	}
 
+	static void Release(Object& object) {								// Free the arrays of a wavefront object
+		delete object.v;
+		delete object.vn;
+		delete object.vnf;
+		delete object.vf;
+	}
+
+	static void Adopt(std::string wvf, Object object) {					// Move a wavefront object read by another thread into the hash map
+		std::unordered_map <std::string, Object>::iterator it = objects.find(wvf);
+		if (object.v == NULL)											// File is missing
+			objects.erase(it);
+		else {
+			object.references = it->second.references;
+			it->second = object;
+		}
+	}
+
+	static void Update() {												// Take the preloaded wavefront objects that have been read
+		std::unordered_map <std::string, std::future<Object> >::iterator it = reading.begin();
+		while (it != reading.end())
+			if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+				Adopt(it->first, it->second.get());
+				it = reading.erase(it);
+			}
+			else
+				it++;
+	}
+
 	static void Exit() {												// Clean up Wavefront Library
-		std::unordered_map <std::string, Object>::iterator it;
-		for (it = objects.begin(); it != objects.end(); it++) {
-			delete it->second.v;
-			delete it->second.vn;
-			delete it->second.vnf;
-			delete it->second.vf;
+		std::unordered_map <std::string, std::future<Object> >::iterator itr;
+		for (itr = reading.begin(); itr != reading.end(); itr++) {
+			Object object = itr->second.get();							// Wait for the reading threads
+			Release(object);
 		}
+		reading.clear();
+		std::unordered_map <std::string, Object>::iterator it;
+		for (it = objects.begin(); it != objects.end(); it++)
+			Release(it->second);
 		objects.clear();
 		std::cout << "Cleaned Wavefront Library.." << std::endl;
 	}
 
-	void Load(std::string _wvf) {										// Load wavefront object into memory
-		if (objects.find(_wvf) != objects.end())						// If wavefront object already exists in hash map
-			return;														// Don't delay reading it from file
+	static Object Read(std::string _wvf) {								// Read wavefront object from file (called by any thread - no OpenGL calls)
+		PROFILE_ZONE("Wavefront::Read");
 		std::string wvf = "models\\" + _wvf + ".obj";
 		std::ifstream file(wvf);
+		Object object;
+		object.v = object.vn = NULL;
+		object.vf = object.vnf = NULL;
+		object.nfaces = 0;
+		object.references = 1;
 		if (file.is_open()) {											// If file opened succesfully
 			std::queue <Point3D> vertices, normals;
 			std::queue <int> vf, nf;
 			Point3D tmp;
-			Object object;
 			char ch;
 			std::string str;
 			int a, b;
@@ -484,21 +657,61 @@ namespace Wavefront {
 				object.vnf[a] = nf.front();
 				nf.pop();
 			}
-			objects[_wvf] = object;										// Insert new wavefront object in hash map if it doesn't exist already
 			std::cout << "Loaded wavefront: " << _wvf << ".obj" << " (Vertices # = " << vertices_number
 				<< ", Normals # = " << normals_number << ", Faces # = " << faces_number / 3.0 << std::endl;
 		}
 		else
 			std::cerr << "Missing wavefront: " << _wvf << ".obj" << std::endl;
+		return object;
+	}
+
+	void Load(std::string wvf) {										// Load wavefront object into memory
+		PROFILE_ZONE("Wavefront::Load");
+		std::unordered_map <std::string, Object>::iterator it = objects.find(wvf);	// Find wavefront in hash map
+		if (it != objects.end()) {										// If wavefront object already exists in hash map
+			it->second.references++;									// Don't delay reading it from file
+			std::unordered_map <std::string, std::future<Object> >::iterator pending = reading.find(wvf);
+			if (pending != reading.end()) {								// Preloaded but still being read - wait for it
+				Adopt(wvf, pending->second.get());
+				reading.erase(pending);
+			}
+			return;
+		}
+		Object object = Read(wvf);
+		if (object.v != NULL)
+			objects[wvf] = object;										// Insert new wavefront object in hash map if it doesn't exist already
+	}
+
+	void Preload(std::string wvf) {										// Start loading wavefront object in the background
+		std::unordered_map <std::string, Object>::iterator it = objects.find(wvf);	// Find wavefront in hash map
+		if (it != objects.end()) {										// If wavefront object already exists in hash map
+			it->second.references++;
+			return;
+		}
+		Object& object = objects[wvf];									// Inserted now - it's empty (not displayed) until the file has been read
+		object.v = object.vn = NULL;
+		object.vf = object.vnf = NULL;
+		object.nfaces = 0;
+		object.references = 1;
+		reading[wvf] = ThreadPool::Shared().async([wvf] { return Read(wvf); });
+	}
+
+	bool IsLoading(std::string wvf) {									// Check if preloaded wavefront object is still being read
+		return reading.find(wvf) != reading.end();
 	}
 
 	void Unload(std::string wvf) {										// Unload wavefront object from memory
 		std::unordered_map <std::string, Object>::iterator it = objects.find(wvf);	// Find wavefront in hash map
 		if (it != objects.end()) {										// If wavefront exists in hash map
-			delete it->second.v;
-			delete it->second.vn;
-			delete it->second.vnf;
-			delete it->second.vf;
+			if (--it->second.references > 0)							// Still loaded by someone else
+				return;
+			std::unordered_map <std::string, std::future<Object> >::iterator pending = reading.find(wvf);
+			if (pending != reading.end()) {								// Preloaded but never taken
+				Object object = pending->second.get();
+				Release(object);
+				reading.erase(pending);
+			}
+			Release(it->second);
 			objects.erase(wvf);
 			std::cout << "Unloaded wavefront: " << wvf << ".obj" << std::endl;
 		}
@@ -519,21 +732,181 @@ namespace Wavefront {
 			glEnd();
 		}
 	}
+
+	bool GetBounds(std::string wvf, float min[3], float max[3]) {		// Box around the vertices of a loaded wavefront object
+		std::unordered_map <std::string, Object>::iterator it = objects.find(wvf);	// Find wavefront in hash map
+		if (it == objects.end() || it->second.v == NULL || it->second.nfaces == 0)	// Missing or still being read
+			return false;
+		for (int i = 0; i < 3; i++) {
+			min[i] = FLT_MAX;
+			max[i] = -FLT_MAX;
+		}
+		for (int i = 0; i < it->second.nfaces; i++) {					// Only the vertices used by the faces
+			const Point3D& point = it->second.v[it->second.vf[i] - 1];
+			GLfloat coordinates[3] = { point.x, point.y, point.z };
+			for (int j = 0; j < 3; j++) {
+				if (coordinates[j] < min[j])
+					min[j] = coordinates[j];
+				if (coordinates[j] > max[j])
+					max[j] = coordinates[j];
+			}
+		}
+		return true;
+	}
 };
 // -------------------- Namespace: Wavefront --------------------
 
+// -------------------- Namespace: Statistics --------------------
+namespace Statistics {
+	static const char* names[COUNTERS] = { "Draw calls", "Vertices", "Texture binds", "Material changes", "Matrix pushes", "Matrix pops", "State toggles" };
+
+	typedef struct Totals {
+		int frames;
+		double counters[COUNTERS];
+	} Totals;
+
+	typedef struct List {
+		unsigned long counters[COUNTERS];
+	} List;
+
+	unsigned long frame[COUNTERS];
+	static unsigned long lastFrame[COUNTERS];
+	static std::map <unsigned int, List> lists;							// Calls recorded for every display list compiled
+	static unsigned int recording = 0;									// Display list being compiled
+	static bool executing = false;										// The display list being compiled is also executed
+	static unsigned long before[COUNTERS];								// Counters when the compilation started
+	static const char* scene = NULL;									// Scene of the frame currently drawn
+	static std::map <std::string, Totals> scenes;						// Totals of every scene drawn so far (ordered by name for the dump)
+	static std::string output = "statistics.txt";
+
+	static void Init() {												// Initialize Statistics Library
+		scenes.clear();
+		lists.clear();
+		for (int i = 0; i < COUNTERS; i++)
+			frame[i] = lastFrame[i] = 0;
+		std::cout << "Initialized Statistics Library.." << std::endl;
+	}
+
+	static void Exit() {												// Clean up Statistics Library
+		scenes.clear();
+		lists.clear();
+		std::cout << "Cleaned Statistics Library.." << std::endl;
+	}
+
+	void BeginList(unsigned int list, bool execute) {					// Start recording the calls compiled into a display list
+		recording = list;
+		executing = execute;
+		for (int i = 0; i < COUNTERS; i++)
+			before[i] = frame[i];
+	}
+
+	void EndList() {													// Stop recording - the calls only compiled are not counted in the frame
+		List calls;
+		for (int i = 0; i < COUNTERS; i++) {
+			calls.counters[i] = frame[i] - before[i];
+			if (!executing)
+				frame[i] = before[i];
+		}
+		lists[recording] = calls;
+	}
+
+	void CallList(unsigned int list) {									// Count the calls recorded for a display list (a draw call if it is unknown)
+		std::map <unsigned int, List>::iterator it = lists.find(list);
+		if (it == lists.end()) {
+			Count(DRAW_CALLS);
+			return;
+		}
+		for (int i = 0; i < COUNTERS; i++)
+			frame[i] += it->second.counters[i];
+	}
+
+	void DeleteLists(unsigned int list, int range) {					// Forget the calls recorded for deleted display lists
+		for (int i = 0; i < range; i++)
+			lists.erase(list + i);
+	}
+
+	void BeginFrame(const char* _scene) {								// Start counting the calls of a new frame of the given scene
+		scene = _scene;
+		for (int i = 0; i < COUNTERS; i++)
+			frame[i] = 0;
+	}
+
+	void EndFrame() {													// Stop counting - the counters are added to the totals of the scene
+		if (scene == NULL)
+			return;
+		std::map <std::string, Totals>::iterator it = scenes.find(scene);
+		if (it == scenes.end()) {
+			Totals totals;
+			totals.frames = 0;
+			for (int i = 0; i < COUNTERS; i++)
+				totals.counters[i] = 0.0;
+			it = scenes.insert(std::make_pair(std::string(scene), totals)).first;
+		}
+		it->second.frames++;
+		for (int i = 0; i < COUNTERS; i++) {
+			it->second.counters[i] += frame[i];
+			lastFrame[i] = frame[i];
+			Profiler::Counter(names[i], frame[i]);						// Counters are also dumped along with the profiled zones
+		}
+		scene = NULL;
+	}
+
+	unsigned long GetLastFrame(int counter) {							// Value of the counter in the last completed frame
+		return lastFrame[counter];
+	}
+
+	double GetAverage(std::string scene, int counter) {					// Average value of the counter per frame of the scene
+		std::map <std::string, Totals>::iterator it = scenes.find(scene);
+		if (it == scenes.end() || it->second.frames == 0)
+			return 0.0;
+		return it->second.counters[counter] / it->second.frames;
+	}
+
+	int GetFrames(std::string scene) {									// Number of frames counted for the scene
+		std::map <std::string, Totals>::iterator it = scenes.find(scene);
+		return it == scenes.end() ? 0 : it->second.frames;
+	}
+
+	void SetOutput(std::string file) {									// Set file where the statistics are written
+		output = file;
+	}
+
+	bool Dump() {														// Write the average counters per frame of every scene
+		std::ofstream file(output);
+		if (!file.is_open()) {
+			std::cerr << "Cannot write statistics: " << output << std::endl;
+			return false;
+		}
+		file.setf(std::ios::fixed);
+		file.precision(1);
+		std::map <std::string, Totals>::iterator it;
+		for (it = scenes.begin(); it != scenes.end(); it++) {
+			file << "Scene: " << it->first << " (Frames # = " << it->second.frames << ")" << std::endl;
+			for (int i = 0; i < COUNTERS; i++)
+				file << "\t" << names[i] << ": " << it->second.counters[i] / it->second.frames << " per frame" << std::endl;
+		}
+		std::cout << "Dumped statistics: " << output << " (Scenes # = " << scenes.size() << ")" << std::endl;
+		return true;
+	}
+};
+// -------------------- Namespace: Statistics --------------------
+
 // -------------------- Namespace: Utilities --------------------
 namespace Utilities {
 	void Init() {														// Initialize Utilities Library
+		Profiler::Init();												// Initialize Profiler Library (first - the others are profiled)
 		Audio::Init();													// Initialize Audio Library
 		Texture::Init();												// Initiaize Texture Library
 		Timer::Init();													// Initialize Timer Library
 		Wavefront::Init();												// Initialize Wavefront Library
+		Statistics::Init();												// Initialize Statistics Library
 		std::cout << "Initialized Utilities Library..\n" << std::endl;
 	}
 
 	void Update() {
 		Audio::Update();												// Update Audio Library
+		Texture::Update();												// Upload a preloaded texture
+		Wavefront::Update();											// Take the preloaded wavefront objects
 	}
 
 	void Exit() {														// Clean up Utilities Library
@@ -541,6 +914,8 @@ namespace Utilities {
 		Texture::Exit();												// Clean up Texture Library
 		Timer::Exit();													// Clean up Timer Library
 		Wavefront::Exit();												// Clean up Wavefront Library
+		Statistics::Exit();												// Clean up Statistics Library
+		Profiler::Exit();												// Clean up Profiler Library
 		std::cout << "Cleaned Utilities Library.." << std::endl;
 	}
 };
@@ -27,6 +27,8 @@
 
 # include <string>
 
+# include "profiler.h"
+
 // -------------------- Some useful functions --------------------
 void Cube(double size);													// Draws a cube with texture coordinates
 void Square(double size);												// Draws a square with texture coordinates
@@ -43,7 +45,9 @@ namespace Utilities {
 // -------------------- Namespace: Audio --------------------
 namespace Audio {
 	void Load(std::string audio);										// Load audio file into memory
-	void Unload(std::string audio);										// Unload audio file from memory
+	void Unload(std::string audio);										// Unload audio file from memory (when every Load of it has been matched by an Unload)
+	void Preload(std::string audio);									// Start loading audio file in the background (counts as a Load - a later Load waits for it)
+	bool IsLoading(std::string audio);									// Check if preloaded audio file is still being read
 
 	void SetVolume(std::string audio, float volume);					// Change volume of specified sound
 	void SetRepeat(std::string audio, bool repeat);						// Set if sound will play repeatedly
@@ -57,6 +61,8 @@ namespace Audio {
 	float GetMasterVolume();											// Get value of master volume
 	void PauseAll();													// Pause all sounds
 	void ResumeAll();													// Resume all sounds
+
+	int GetMemoryUsage();												// Get memory currently allocated by FMOD (in bytes)
 };
 // -------------------- Namespace: Audio --------------------
 
@@ -66,9 +72,13 @@ namespace Texture {
 	void Disable();														// Disable Texturing
 
 	void Load(std::string texture);										// Load texture file into memory
-	void Unload(std::string texture);									// Unload texture from memory
+	void Unload(std::string texture);									// Unload texture from memory (when every Load of it has been matched by an Unload)
+	void Preload(std::string texture);									// Start loading texture file in the background (counts as a Load - decoded by another thread & uploaded by Utilities::Update)
+	bool IsLoading(std::string texture);								// Check if preloaded texture hasn't been uploaded yet
 
 	void Use(std::string texture);										// Applies texture to the next displayed objects
+
+	int GetMemoryUsage();												// Get memory used by the loaded textures (in bytes)
 };
 // -------------------- Namespace: Texture --------------------
 
@@ -78,16 +88,44 @@ namespace Timer {
 	void Stop();														// Stop Timer
 
 	int GetElapsedTime();												// Get the elapsed time (int milliseconds)
+	double GetTime();													// Get the time since the Timer Library was initialized (in milliseconds - high resolution)
 };
 // -------------------- Namespace: Timer --------------------
 
 // -------------------- Namespace: Wavefront --------------------
 namespace Wavefront {
 	void Load(std::string wvf);											// Load wavefront object into memory
-	void Unload(std::string wvf);										// Unload wavefront object from memory
+	void Unload(std::string wvf);										// Unload wavefront object from memory (when every Load of it has been matched by an Unload)
+	void Preload(std::string wvf);										// Start loading wavefront object in the background (counts as a Load - read by another thread)
+	bool IsLoading(std::string wvf);									// Check if preloaded wavefront object is still being read
 
 	void Display(std::string wvf);										// Display wavefront object in the center of the screen
+	bool GetBounds(std::string wvf, float min[3], float max[3]);		// Box around the vertices of a loaded wavefront object - false if it isn't loaded
 };
 // -------------------- Namespace: Wavefront --------------------
 
+// -------------------- Namespace: Statistics --------------------
+namespace Statistics {													// Per frame OpenGL call counters - the calls are counted by the wrappers of glstatistics.h
+	enum Counters { DRAW_CALLS, VERTICES, TEXTURE_BINDS, MATERIAL_CHANGES, MATRIX_PUSHES, MATRIX_POPS, STATE_TOGGLES, COUNTERS };
+
+	extern unsigned long frame[COUNTERS];								// Counters of the frame currently drawn
+	inline void Count(int counter, unsigned long times = 1) { frame[counter] += times; }
+
+	void BeginList(unsigned int list, bool execute);					// Start recording the calls compiled into a display list
+	void EndList();														// Stop recording - the calls only compiled are not counted in the frame
+	void CallList(unsigned int list);									// Count the calls recorded for a display list (a draw call if it is unknown)
+	void DeleteLists(unsigned int list, int range);						// Forget the calls recorded for deleted display lists
+
+	void BeginFrame(const char* scene);									// Start counting the calls of a new frame of the given scene
+	void EndFrame();													// Stop counting - the counters are added to the totals of the scene
+
+	unsigned long GetLastFrame(int counter);							// Value of the counter in the last completed frame
+	double GetAverage(std::string scene, int counter);					// Average value of the counter per frame of the scene
+	int GetFrames(std::string scene);									// Number of frames counted for the scene
+
+	void SetOutput(std::string file);									// Set file where the statistics are written (by default statistics.txt)
+	bool Dump();														// Write the average counters per frame of every scene
+};
+// -------------------- Namespace: Statistics --------------------
+
 # endif  // # ifndef __UTILITIES__
\ No newline at end of file
@@ -0,0 +1,62 @@
+/* MIT License
+*
+* Copyright(c) 2016 Spyros Alertas
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* (copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+
+
+# ifndef __VARINT__
+# define __VARINT__
+
+# include <vector>
+
+// -------------------- Namespace: Varint --------------------
+namespace Varint {														// Numbers stored in 7 bits per byte (low first) - small numbers take a single byte
+	inline void Write(std::vector <unsigned char>& data, unsigned value) {
+		while (value >= 0x80) {
+			data.push_back((unsigned char)(value | 0x80));
+			value >>= 7;
+		}
+		data.push_back((unsigned char)value);
+	}
+
+	inline bool Read(const std::vector <unsigned char>& data, unsigned& cursor, unsigned& value) {	// false: data is over (or corrupted)
+		value = 0;
+		for (int shift = 0; shift < 35 && cursor < data.size(); shift += 7) {
+			unsigned char byte = data[cursor++];
+			value |= (unsigned)(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	inline unsigned ZigZag(int value) {									// Signed to unsigned - small negative numbers stay small
+		return ((unsigned)value << 1) ^ (unsigned)(value >> 31);
+	}
+
+	inline int UnZigZag(unsigned value) {
+		return (int)(value >> 1) ^ -(int)(value & 1);
+	}
+};
+// -------------------- Namespace: Varint --------------------
+
+# endif  // # ifndef __VARINT__
\ No newline at end of file